@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_copy.dir/bench_copy.cpp.o"
+  "CMakeFiles/bench_copy.dir/bench_copy.cpp.o.d"
+  "bench_copy"
+  "bench_copy.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_copy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_intrusive.dir/bench_intrusive.cpp.o"
+  "CMakeFiles/bench_intrusive.dir/bench_intrusive.cpp.o.d"
+  "bench_intrusive"
+  "bench_intrusive.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_intrusive.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
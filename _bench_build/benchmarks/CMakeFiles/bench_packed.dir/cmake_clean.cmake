@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_packed.dir/bench_packed.cpp.o"
+  "CMakeFiles/bench_packed.dir/bench_packed.cpp.o.d"
+  "bench_packed"
+  "bench_packed.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_packed.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_rollback.dir/bench_rollback.cpp.o"
+  "CMakeFiles/bench_rollback.dir/bench_rollback.cpp.o.d"
+  "bench_rollback"
+  "bench_rollback.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_rollback.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
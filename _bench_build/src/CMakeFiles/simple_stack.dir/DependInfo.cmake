@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/simple_stack.cpp" "src/CMakeFiles/simple_stack.dir/simple_stack.cpp.o" "gcc" "src/CMakeFiles/simple_stack.dir/simple_stack.cpp.o.d"
+  "/root/repo/src/simple_stack_char.cpp" "src/CMakeFiles/simple_stack.dir/simple_stack_char.cpp.o" "gcc" "src/CMakeFiles/simple_stack.dir/simple_stack_char.cpp.o.d"
+  "/root/repo/src/simple_stack_double.cpp" "src/CMakeFiles/simple_stack.dir/simple_stack_double.cpp.o" "gcc" "src/CMakeFiles/simple_stack.dir/simple_stack_double.cpp.o.d"
+  "/root/repo/src/simple_stack_int.cpp" "src/CMakeFiles/simple_stack.dir/simple_stack_int.cpp.o" "gcc" "src/CMakeFiles/simple_stack.dir/simple_stack_int.cpp.o.d"
+  "/root/repo/src/simple_stack_int64.cpp" "src/CMakeFiles/simple_stack.dir/simple_stack_int64.cpp.o" "gcc" "src/CMakeFiles/simple_stack.dir/simple_stack_int64.cpp.o.d"
+  "/root/repo/src/simple_stack_string.cpp" "src/CMakeFiles/simple_stack.dir/simple_stack_string.cpp.o" "gcc" "src/CMakeFiles/simple_stack.dir/simple_stack_string.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
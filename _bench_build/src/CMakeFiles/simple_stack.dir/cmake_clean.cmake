@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/simple_stack.dir/simple_stack.cpp.o"
+  "CMakeFiles/simple_stack.dir/simple_stack.cpp.o.d"
+  "CMakeFiles/simple_stack.dir/simple_stack_char.cpp.o"
+  "CMakeFiles/simple_stack.dir/simple_stack_char.cpp.o.d"
+  "CMakeFiles/simple_stack.dir/simple_stack_double.cpp.o"
+  "CMakeFiles/simple_stack.dir/simple_stack_double.cpp.o.d"
+  "CMakeFiles/simple_stack.dir/simple_stack_int.cpp.o"
+  "CMakeFiles/simple_stack.dir/simple_stack_int.cpp.o.d"
+  "CMakeFiles/simple_stack.dir/simple_stack_int64.cpp.o"
+  "CMakeFiles/simple_stack.dir/simple_stack_int64.cpp.o.d"
+  "CMakeFiles/simple_stack.dir/simple_stack_string.cpp.o"
+  "CMakeFiles/simple_stack.dir/simple_stack_string.cpp.o.d"
+  "libsimple_stack.a"
+  "libsimple_stack.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/simple_stack.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
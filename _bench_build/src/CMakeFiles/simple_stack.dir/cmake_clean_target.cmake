@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libsimple_stack.a"
+)
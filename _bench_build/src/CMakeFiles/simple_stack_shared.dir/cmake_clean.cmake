@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/simple_stack_shared.dir/simple_stack.cpp.o"
+  "CMakeFiles/simple_stack_shared.dir/simple_stack.cpp.o.d"
+  "CMakeFiles/simple_stack_shared.dir/simple_stack_char.cpp.o"
+  "CMakeFiles/simple_stack_shared.dir/simple_stack_char.cpp.o.d"
+  "CMakeFiles/simple_stack_shared.dir/simple_stack_double.cpp.o"
+  "CMakeFiles/simple_stack_shared.dir/simple_stack_double.cpp.o.d"
+  "CMakeFiles/simple_stack_shared.dir/simple_stack_int.cpp.o"
+  "CMakeFiles/simple_stack_shared.dir/simple_stack_int.cpp.o.d"
+  "CMakeFiles/simple_stack_shared.dir/simple_stack_int64.cpp.o"
+  "CMakeFiles/simple_stack_shared.dir/simple_stack_int64.cpp.o.d"
+  "CMakeFiles/simple_stack_shared.dir/simple_stack_string.cpp.o"
+  "CMakeFiles/simple_stack_shared.dir/simple_stack_string.cpp.o.d"
+  "libsimple_stack.pdb"
+  "libsimple_stack.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/simple_stack_shared.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
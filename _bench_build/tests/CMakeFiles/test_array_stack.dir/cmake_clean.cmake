@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_array_stack.dir/test_array_stack.cpp.o"
+  "CMakeFiles/test_array_stack.dir/test_array_stack.cpp.o.d"
+  "test_array_stack"
+  "test_array_stack.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_array_stack.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
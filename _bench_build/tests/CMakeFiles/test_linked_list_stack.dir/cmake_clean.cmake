@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_linked_list_stack.dir/test_linked_list_stack.cpp.o"
+  "CMakeFiles/test_linked_list_stack.dir/test_linked_list_stack.cpp.o.d"
+  "test_linked_list_stack"
+  "test_linked_list_stack.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_linked_list_stack.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_simple_stack_c.dir/test_simple_stack_c.cpp.o"
+  "CMakeFiles/test_simple_stack_c.dir/test_simple_stack_c.cpp.o.d"
+  "test_simple_stack_c"
+  "test_simple_stack_c.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_simple_stack_c.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_stack_aggregate.dir/test_stack_aggregate.cpp.o"
+  "CMakeFiles/test_stack_aggregate.dir/test_stack_aggregate.cpp.o.d"
+  "test_stack_aggregate"
+  "test_stack_aggregate.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_stack_aggregate.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_stack_arena.dir/test_stack_arena.cpp.o"
+  "CMakeFiles/test_stack_arena.dir/test_stack_arena.cpp.o.d"
+  "test_stack_arena"
+  "test_stack_arena.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_stack_arena.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_stack_blob.dir/test_stack_blob.cpp.o"
+  "CMakeFiles/test_stack_blob.dir/test_stack_blob.cpp.o.d"
+  "test_stack_blob"
+  "test_stack_blob.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_stack_blob.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
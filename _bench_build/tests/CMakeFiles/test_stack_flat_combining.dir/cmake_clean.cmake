@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_stack_flat_combining.dir/test_stack_flat_combining.cpp.o"
+  "CMakeFiles/test_stack_flat_combining.dir/test_stack_flat_combining.cpp.o.d"
+  "test_stack_flat_combining"
+  "test_stack_flat_combining.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_stack_flat_combining.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
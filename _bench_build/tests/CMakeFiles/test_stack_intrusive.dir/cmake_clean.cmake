@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_stack_intrusive.dir/test_stack_intrusive.cpp.o"
+  "CMakeFiles/test_stack_intrusive.dir/test_stack_intrusive.cpp.o.d"
+  "test_stack_intrusive"
+  "test_stack_intrusive.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_stack_intrusive.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_stack_packed.dir/test_stack_packed.cpp.o"
+  "CMakeFiles/test_stack_packed.dir/test_stack_packed.cpp.o.d"
+  "test_stack_packed"
+  "test_stack_packed.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_stack_packed.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_stack_ring.dir/test_stack_ring.cpp.o"
+  "CMakeFiles/test_stack_ring.dir/test_stack_ring.cpp.o.d"
+  "test_stack_ring"
+  "test_stack_ring.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_stack_ring.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_stack_spill.dir/test_stack_spill.cpp.o"
+  "CMakeFiles/test_stack_spill.dir/test_stack_spill.cpp.o.d"
+  "test_stack_spill"
+  "test_stack_spill.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_stack_spill.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
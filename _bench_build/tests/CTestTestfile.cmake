@@ -0,0 +1,28 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_bench_build/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(ArrayStackTest "/root/repo/_bench_build/tests/test_array_stack")
+set_tests_properties(ArrayStackTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;43;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(LinkedListStackTest "/root/repo/_bench_build/tests/test_linked_list_stack")
+set_tests_properties(LinkedListStackTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;44;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(StackArenaTest "/root/repo/_bench_build/tests/test_stack_arena")
+set_tests_properties(StackArenaTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;45;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(StackAggregateTest "/root/repo/_bench_build/tests/test_stack_aggregate")
+set_tests_properties(StackAggregateTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;46;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(StackFlatCombiningTest "/root/repo/_bench_build/tests/test_stack_flat_combining")
+set_tests_properties(StackFlatCombiningTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;47;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(StackIntrusiveTest "/root/repo/_bench_build/tests/test_stack_intrusive")
+set_tests_properties(StackIntrusiveTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;48;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(StackBlobTest "/root/repo/_bench_build/tests/test_stack_blob")
+set_tests_properties(StackBlobTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;49;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(StackPackedTest "/root/repo/_bench_build/tests/test_stack_packed")
+set_tests_properties(StackPackedTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;50;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(StackRingTest "/root/repo/_bench_build/tests/test_stack_ring")
+set_tests_properties(StackRingTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;51;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(StackSpillTest "/root/repo/_bench_build/tests/test_stack_spill")
+set_tests_properties(StackSpillTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;52;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(SimpleStackCTest "/root/repo/_bench_build/tests/test_simple_stack_c")
+set_tests_properties(SimpleStackCTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;53;add_test;/root/repo/tests/CMakeLists.txt;0;")
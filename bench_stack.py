@@ -0,0 +1,49 @@
+"""Compares `stack.py` with `native_stack.py`.
+
+Usage: python3 bench_stack.py [number_of_elements]
+
+Run `./run.sh` first (or point $SIMPLE_STACK_LIBRARY at libsimple_stack.so).
+"""
+
+import sys
+import timeit
+
+import native_stack
+import stack
+
+
+def push_pop(cls, n):
+    s = cls(n)
+    for i in range(n):
+        s.push(i)
+    for _ in range(n):
+        s.pop()
+
+
+def push_pop_many(cls, n):
+    s = cls(n)
+    s.push_many(range(n))
+    s.pop_many(n)
+
+
+def main():
+    n = int(sys.argv[1]) if len(sys.argv) > 1 else 10000
+    cases = [
+        ("stack.StackList", lambda: push_pop(stack.StackList, n)),
+        ("stack.StackLinkedList", lambda: push_pop(stack.StackLinkedList, n)),
+        ("native_stack.StackList", lambda: push_pop(native_stack.StackList, n)),
+        ("native_stack.StackLinkedList", lambda: push_pop(native_stack.StackLinkedList, n)),
+        ("native_stack.StackList (batch)", lambda: push_pop_many(native_stack.StackList, n)),
+        (
+            "native_stack.StackLinkedList (batch)",
+            lambda: push_pop_many(native_stack.StackLinkedList, n),
+        ),
+    ]
+    print(f"push {n} integers, then pop them")
+    for name, case in cases:
+        seconds = min(timeit.repeat(case, number=1, repeat=3))
+        print(f"{name:40s} {seconds * 1e3:10.2f} ms {seconds / (2 * n) * 1e9:8.1f} ns/op")
+
+
+if __name__ == "__main__":
+    main()
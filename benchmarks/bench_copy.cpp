@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "simple_stack.h"
+
+// Copy a full stack with `cloneParallel(range(0))`. The `Auto` variants use
+// the copy constructor, which picks the number of threads on its own. It
+// keeps the few vectors here on one thread, as it only times copies of many
+// elements.
+
+// 2^25 int64 elements, 256 MiB
+static const int kNumberOfIntegers = 1 << 25;
+// 20 vectors of 2^22 ints, 320 MiB in total
+static const int kNumberOfVectors = 20;
+static const int kVectorSize = 1 << 22;
+
+static StackArray<std::int64_t> &getIntegers() {
+  static StackArray<std::int64_t> stack(kNumberOfIntegers);
+  while (stack.isFull() == false) {
+    stack.push(stack.getNumberOfElements());
+  }
+  return stack;
+}
+
+static StackArray<std::vector<int>> &getVectors() {
+  static StackArray<std::vector<int>> stack(kNumberOfVectors);
+  while (stack.isFull() == false) {
+    stack.push(std::vector<int>(kVectorSize, stack.getNumberOfElements()));
+  }
+  return stack;
+}
+
+static void BM_CloneIntegers(benchmark::State &state) {
+  StackArray<std::int64_t> &stack = getIntegers();
+  for (auto _ : state) {
+    StackArray<std::int64_t> copy =
+        stack.cloneParallel(static_cast<int>(state.range(0)));
+    benchmark::DoNotOptimize(copy.getArray());
+  }
+  state.SetBytesProcessed(state.iterations() * kNumberOfIntegers *
+                          sizeof(std::int64_t));
+}
+
+static void BM_CopyIntegersAuto(benchmark::State &state) {
+  StackArray<std::int64_t> &stack = getIntegers();
+  for (auto _ : state) {
+    StackArray<std::int64_t> copy = stack;
+    benchmark::DoNotOptimize(copy.getArray());
+  }
+  state.SetBytesProcessed(state.iterations() * kNumberOfIntegers *
+                          sizeof(std::int64_t));
+}
+
+// Copy assignment into a stack of the same capacity, which reuses its storage
+static void BM_AssignIntegersAuto(benchmark::State &state) {
+  StackArray<std::int64_t> &stack = getIntegers();
+  StackArray<std::int64_t> copy(kNumberOfIntegers);
+  for (auto _ : state) {
+    copy = stack;
+    benchmark::DoNotOptimize(copy.getArray());
+  }
+  state.SetBytesProcessed(state.iterations() * kNumberOfIntegers *
+                          sizeof(std::int64_t));
+}
+
+static void BM_CloneVectors(benchmark::State &state) {
+  StackArray<std::vector<int>> &stack = getVectors();
+  for (auto _ : state) {
+    StackArray<std::vector<int>> copy =
+        stack.cloneParallel(static_cast<int>(state.range(0)));
+    benchmark::DoNotOptimize(copy.getArray());
+  }
+  state.SetBytesProcessed(state.iterations() * kNumberOfVectors *
+                          kVectorSize * sizeof(int));
+}
+
+static void BM_CopyVectorsAuto(benchmark::State &state) {
+  StackArray<std::vector<int>> &stack = getVectors();
+  for (auto _ : state) {
+    StackArray<std::vector<int>> copy = stack;
+    benchmark::DoNotOptimize(copy.getArray());
+  }
+  state.SetBytesProcessed(state.iterations() * kNumberOfVectors *
+                          kVectorSize * sizeof(int));
+}
+
+BENCHMARK(BM_CloneIntegers)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_CopyIntegersAuto)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_AssignIntegersAuto)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_CloneVectors)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_CopyVectorsAuto)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <mutex>
+
+#include "simple_stack.h"
+#include "stack_flat_combining.h"
+
+// The baseline: every operation takes one global lock.
+template <class T>
+class StackMutex {
+  std::mutex mutex;
+  StackArray<T> storage;
+
+ public:
+  StackMutex(int capacity) : storage(capacity) {}
+
+  void push(T value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    storage.push(value);
+  }
+
+  T pop() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return storage.pop();
+  }
+};
+
+const int kCapacity = 1 << 24;
+
+// `range(0)` is the percentage of pushes. The stack starts half full so that
+// running out of either end is rare; when it happens the exception is caught
+// and counted as an operation.
+template <class StackType>
+static void BM_PushPop(benchmark::State &state) {
+  static std::unique_ptr<StackType> stack;
+  if (state.thread_index() == 0) {
+    stack = std::make_unique<StackType>(kCapacity);
+    for (int i = 0; i < kCapacity / 2; i++) {
+      stack->push(i);
+    }
+  }
+  int pushPercentage = static_cast<int>(state.range(0));
+  unsigned seed = 12345u + static_cast<unsigned>(state.thread_index());
+  for (auto _ : state) {
+    seed = seed * 1103515245u + 12345u;
+    try {
+      if (static_cast<int>((seed >> 16) % 100) < pushPercentage) {
+        stack->push(1);
+      } else {
+        benchmark::DoNotOptimize(stack->pop());
+      }
+    } catch (const StackOverflowError &) {
+    } catch (const StackUnderflowError &) {
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    stack = nullptr;
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_PushPop, StackMutex<int>)
+    ->Arg(25)
+    ->Arg(50)
+    ->Arg(75)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PushPop, StackFlatCombining<int>)
+    ->Arg(25)
+    ->Arg(50)
+    ->Arg(75)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
@@ -0,0 +1,111 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "simple_stack.h"
+#include "stack_intrusive.h"
+
+// A pooled object of a typical small size.
+struct Item {
+  Item *next = nullptr;
+  char payload[56];
+};
+
+struct SharedItem {
+  std::atomic<SharedItem *> next{nullptr};
+  char payload[56];
+};
+
+// Push all objects of a pool, then pop them all.
+
+static void BM_LinkedListCopies(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  std::vector<Item> pool(count);
+  StackLinkedList<Item> stack(count);
+  for (auto _ : state) {
+    for (Item &item : pool) {
+      stack.push(item);
+    }
+    while (stack.isEmpty() == false) {
+      benchmark::DoNotOptimize(stack.pop());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_LinkedListPointers(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  std::vector<Item> pool(count);
+  StackLinkedList<Item *> stack(count);
+  for (auto _ : state) {
+    for (Item &item : pool) {
+      stack.push(&item);
+    }
+    while (stack.isEmpty() == false) {
+      benchmark::DoNotOptimize(stack.pop());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_Intrusive(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  std::vector<Item> pool(count);
+  StackIntrusive<Item> stack(count);
+  for (auto _ : state) {
+    for (Item &item : pool) {
+      stack.push(&item);
+    }
+    while (stack.isEmpty() == false) {
+      benchmark::DoNotOptimize(stack.pop());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_IntrusiveLockFree(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  std::vector<SharedItem> pool(count);
+  StackIntrusiveLockFree<SharedItem> stack;
+  for (auto _ : state) {
+    for (SharedItem &item : pool) {
+      stack.push(&item);
+    }
+    while (SharedItem *item = stack.tryPop()) {
+      benchmark::DoNotOptimize(item);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Threads share one free-list and take/return an object per iteration.
+static void BM_IntrusiveLockFreeShared(benchmark::State &state) {
+  static std::unique_ptr<std::vector<SharedItem>> pool;
+  static std::unique_ptr<StackIntrusiveLockFree<SharedItem>> freeList;
+  if (state.thread_index() == 0) {
+    pool = std::make_unique<std::vector<SharedItem>>(1024);
+    freeList = std::make_unique<StackIntrusiveLockFree<SharedItem>>();
+    for (SharedItem &item : *pool) {
+      freeList->push(&item);
+    }
+  }
+  for (auto _ : state) {
+    SharedItem *item = freeList->tryPop();
+    if (item != nullptr) {
+      freeList->push(item);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    freeList = nullptr;
+    pool = nullptr;
+  }
+}
+
+BENCHMARK(BM_LinkedListCopies)->Range(64, 1 << 16);
+BENCHMARK(BM_LinkedListPointers)->Range(64, 1 << 16);
+BENCHMARK(BM_Intrusive)->Range(64, 1 << 16);
+BENCHMARK(BM_IntrusiveLockFree)->Range(64, 1 << 16);
+BENCHMARK(BM_IntrusiveLockFreeShared)->ThreadRange(1, 8)->UseRealTime();
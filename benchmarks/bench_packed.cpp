@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "simple_stack.h"
+#include "stack_packed.h"
+
+// Push `range(0)` booleans, then pop them. The `bytes` counter is the memory
+// used for the elements.
+
+static void BM_ArrayBool(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  StackArray<bool> stack(count);
+  for (auto _ : state) {
+    for (int i = 0; i < count; i++) {
+      stack.push((i & 3) == 0);
+    }
+    int ones = 0;
+    while (stack.isEmpty() == false) {
+      ones += stack.pop();
+    }
+    benchmark::DoNotOptimize(ones);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.counters["bytes"] = static_cast<double>(count * sizeof(bool));
+}
+
+static void BM_PackedBool(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  StackPacked<1> stack(count);
+  for (auto _ : state) {
+    for (int i = 0; i < count; i++) {
+      stack.push((i & 3) == 0);
+    }
+    int ones = 0;
+    while (stack.isEmpty() == false) {
+      ones += stack.pop();
+    }
+    benchmark::DoNotOptimize(ones);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.counters["bytes"] = static_cast<double>(stack.getNumberOfBytes());
+}
+
+static void BM_PackedBoolMany(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  StackPacked<1> stack(count);
+  std::vector<std::uint64_t> packed((count + 63) / 64, 0x1111111111111111ull);
+  for (auto _ : state) {
+    stack.pushMany(packed.data(), count);
+    stack.popMany(packed.data(), count);
+    benchmark::DoNotOptimize(packed.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.counters["bytes"] = static_cast<double>(stack.getNumberOfBytes());
+}
+
+// Count the `true` elements of a full stack.
+static void BM_ArrayBoolCount(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  StackArray<bool> stack(count);
+  for (int i = 0; i < count; i++) {
+    stack.push((i & 3) == 0);
+  }
+  for (auto _ : state) {
+    const bool *array = stack.getArray();
+    int ones = 0;
+    for (int i = 0; i < count; i++) {
+      ones += array[i];
+    }
+    benchmark::DoNotOptimize(ones);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_PackedBoolCount(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  StackPacked<1> stack(count);
+  for (int i = 0; i < count; i++) {
+    stack.push((i & 3) == 0);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stack.getPopulationCount());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BM_ArrayBool)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PackedBool)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PackedBoolMany)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_ArrayBoolCount)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PackedBoolCount)->Range(1 << 10, 1 << 22);
@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "simple_stack.h"
+
+// Push `range(0)` speculative elements on top of a saved depth and go back to
+// it, either by popping one by one or with a single `rollback()`.
+
+template <class StackType, class T>
+static void BM_PopLoop(benchmark::State &state) {
+  int depth = static_cast<int>(state.range(0));
+  StackType stack(depth + 1);
+  stack.push(T());
+  for (auto _ : state) {
+    for (int i = 0; i < depth; i++) {
+      stack.push(T());
+    }
+    while (stack.getNumberOfElements() > 1) {
+      benchmark::DoNotOptimize(stack.pop());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * depth);
+}
+
+template <class StackType, class T>
+static void BM_Rollback(benchmark::State &state) {
+  int depth = static_cast<int>(state.range(0));
+  StackType stack(depth + 1);
+  stack.push(T());
+  StackMark mark = stack.mark();
+  for (auto _ : state) {
+    for (int i = 0; i < depth; i++) {
+      stack.push(T());
+    }
+    stack.rollback(mark);
+  }
+  state.SetItemsProcessed(state.iterations() * depth);
+}
+
+BENCHMARK_TEMPLATE(BM_PopLoop, StackArray<int>, int)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Rollback, StackArray<int>, int)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_PopLoop, StackArray<std::string>, std::string)
+    ->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Rollback, StackArray<std::string>, std::string)
+    ->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_PopLoop, StackLinkedList<int>, int)->Range(8, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Rollback, StackLinkedList<int>, int)->Range(8, 1 << 16);
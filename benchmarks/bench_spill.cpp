@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include "simple_stack.h"
+#include "stack_spill.h"
+
+// Push `range(0)` int64 elements, then pop them. `StackSpill` keeps 8 blocks
+// of 4096 elements (256 KiB) in memory and spills the rest to a temporary
+// file. The `stalls` counter is the number of pops per run that had to wait
+// for their block to come back from the file.
+
+static void BM_ArrayPushPop(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  StackArray<std::int64_t> stack(count);
+  for (auto _ : state) {
+    for (int i = 0; i < count; i++) {
+      stack.push(i);
+    }
+    std::int64_t sum = 0;
+    while (stack.isEmpty() == false) {
+      sum += stack.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_SpillPushPop(benchmark::State &state) {
+  int count = static_cast<int>(state.range(0));
+  StackSpill<std::int64_t> stack(count);
+  for (auto _ : state) {
+    for (int i = 0; i < count; i++) {
+      stack.push(i);
+    }
+    std::int64_t sum = 0;
+    while (stack.isEmpty() == false) {
+      sum += stack.pop();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.counters["stalls"] = benchmark::Counter(
+      static_cast<double>(stack.getNumberOfStalls()),
+      benchmark::Counter::kAvgIterations);
+}
+
+// Random walk around a depth of `range(0)`, which is what a depth-first
+// search does to the top of its stack.
+static void BM_SpillRandomWalk(benchmark::State &state) {
+  int depth = static_cast<int>(state.range(0));
+  StackSpill<std::int64_t> stack(2 * depth);
+  for (int i = 0; i < depth; i++) {
+    stack.push(i);
+  }
+  std::uint32_t random = 1;
+  for (auto _ : state) {
+    for (int i = 0; i < 1024; i++) {
+      random = random * 1664525u + 1013904223u;
+      if ((random >> 31) != 0 && stack.isFull() == false) {
+        stack.push(i);
+      } else if (stack.isEmpty() == false) {
+        benchmark::DoNotOptimize(stack.pop());
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * 1024);
+  state.counters["blockWrites"] =
+      static_cast<double>(stack.getNumberOfBlockWrites());
+}
+
+BENCHMARK(BM_ArrayPushPop)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK(BM_SpillPushPop)->Arg(1 << 16)->Arg(1 << 22);
+BENCHMARK(BM_SpillRandomWalk)->Arg(1 << 20);
@@ -0,0 +1,134 @@
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef ASYNC_EXECUTOR_H
+#define ASYNC_EXECUTOR_H
+
+// Minimal coroutine plumbing to drive `AsyncStack`. It is meant for tests and
+// small tools, not as a general-purpose runtime.
+
+// A coroutine return type that starts eagerly and destroys itself when done.
+struct DetachedTask {
+  struct promise_type {
+    DetachedTask get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+// Awaitable that moves the awaiting coroutine onto `Executor`.
+template <class Executor>
+class ScheduleAwaiter {
+  Executor *executor;
+
+ public:
+  explicit ScheduleAwaiter(Executor *executor) : executor(executor) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    executor->post(handle);
+  }
+
+  void await_resume() const noexcept {}
+};
+
+// Runs coroutines on the thread that calls `run()`.
+class SingleThreadExecutor {
+  std::mutex mutex;
+  std::deque<std::coroutine_handle<>> queue;
+
+ public:
+  void post(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back(handle);
+  }
+
+  [[nodiscard]] ScheduleAwaiter<SingleThreadExecutor> schedule() {
+    return ScheduleAwaiter<SingleThreadExecutor>(this);
+  }
+
+  // Resume queued coroutines until the queue is empty.
+  void run() {
+    while (true) {
+      std::coroutine_handle<> handle;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) {
+          return;
+        }
+        handle = queue.front();
+        queue.pop_front();
+      }
+      handle.resume();
+    }
+  }
+};
+
+// Runs coroutines on a fixed number of worker threads. The destructor waits
+// until every queued coroutine has been resumed.
+class ThreadPoolExecutor {
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::deque<std::coroutine_handle<>> queue;
+  std::vector<std::thread> workers;
+  bool stopping = false;
+
+  void work() {
+    while (true) {
+      std::coroutine_handle<> handle;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+          return;
+        }
+        handle = queue.front();
+        queue.pop_front();
+      }
+      handle.resume();
+    }
+  }
+
+ public:
+  ThreadPoolExecutor(int numberOfThreads) {
+    for (int i = 0; i < numberOfThreads; i++) {
+      workers.emplace_back([this] { work(); });
+    }
+  }
+
+  ThreadPoolExecutor(const ThreadPoolExecutor &other) = delete;
+  ThreadPoolExecutor &operator=(const ThreadPoolExecutor &other) = delete;
+
+  ~ThreadPoolExecutor() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    condition.notify_all();
+    for (std::thread &worker : workers) {
+      worker.join();
+    }
+  }
+
+  void post(std::coroutine_handle<> handle) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue.push_back(handle);
+    }
+    condition.notify_one();
+  }
+
+  [[nodiscard]] ScheduleAwaiter<ThreadPoolExecutor> schedule() {
+    return ScheduleAwaiter<ThreadPoolExecutor>(this);
+  }
+};
+
+#endif  // ASYNC_EXECUTOR_H
@@ -0,0 +1,184 @@
+#include <coroutine>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "simple_stack.h"
+
+#ifndef ASYNC_STACK_H
+#define ASYNC_STACK_H
+
+#if !defined(__cpp_impl_coroutine)
+#error "async_stack.h needs C++20 coroutines. Configure with ENABLE_COROUTINES."
+#endif
+
+// A bounded concurrent stack for coroutines.
+//
+// `co_await stack.pop()` suspends the calling coroutine while the stack is
+// empty and `co_await stack.push(value)` suspends it while the stack is full.
+// A suspended coroutine is resumed directly by the opposite operation, on the
+// thread that performed it, so no thread ever sleeps in the kernel waiting for
+// an element. The mutex only guards the short bookkeeping sections.
+//
+// Waiters are served first come, first served. Destroying the stack while
+// coroutines are suspended on it leaves them suspended forever.
+template <class T>
+class AsyncStack {
+ public:
+  class PopAwaiter;
+  class PushAwaiter;
+
+ private:
+  // Intrusive FIFO of suspended awaiters. The awaiters live in the coroutine
+  // frames, so waiting never allocates.
+  template <class Awaiter>
+  struct WaitQueue {
+    Awaiter *head = nullptr;
+    Awaiter *tail = nullptr;
+
+    void enqueue(Awaiter *awaiter) {
+      awaiter->next = nullptr;
+      if (tail == nullptr) {
+        head = awaiter;
+      } else {
+        tail->next = awaiter;
+      }
+      tail = awaiter;
+    }
+
+    Awaiter *dequeue() {
+      Awaiter *awaiter = head;
+      if (awaiter != nullptr) {
+        head = awaiter->next;
+        if (head == nullptr) {
+          tail = nullptr;
+        }
+      }
+      return awaiter;
+    }
+
+    bool isEmpty() const { return head == nullptr; }
+  };
+
+  std::mutex mutex;
+  StackArray<T> storage;
+  WaitQueue<PopAwaiter> popWaiters;
+  WaitQueue<PushAwaiter> pushWaiters;
+
+  // Return true if the popping coroutine has to suspend.
+  bool popOrWait(PopAwaiter *popper) {
+    std::coroutine_handle<> toResume;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (storage.isEmpty()) {
+        popWaiters.enqueue(popper);
+        return true;
+      }
+      popper->value = storage.pop();
+      // A slot became free. Hand it to the oldest waiting pusher.
+      if (PushAwaiter *pusher = pushWaiters.dequeue()) {
+        storage.push(std::move(pusher->value));
+        toResume = pusher->handle;
+      }
+    }
+    if (toResume) {
+      toResume.resume();
+    }
+    return false;
+  }
+
+  // Return true if the pushing coroutine has to suspend.
+  bool pushOrWait(PushAwaiter *pusher) {
+    std::coroutine_handle<> toResume;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (PopAwaiter *popper = popWaiters.dequeue()) {
+        // Poppers only wait on an empty stack, so the value goes straight to
+        // the oldest of them without touching the storage.
+        popper->value = std::move(pusher->value);
+        toResume = popper->handle;
+      } else if (storage.isFull()) {
+        pushWaiters.enqueue(pusher);
+        return true;
+      } else {
+        storage.push(std::move(pusher->value));
+      }
+    }
+    if (toResume) {
+      toResume.resume();
+    }
+    return false;
+  }
+
+ public:
+  class PopAwaiter {
+    friend class AsyncStack;
+    friend struct WaitQueue<PopAwaiter>;
+
+    AsyncStack *stack;
+    std::optional<T> value;
+    std::coroutine_handle<> handle;
+    PopAwaiter *next = nullptr;
+
+   public:
+    explicit PopAwaiter(AsyncStack *stack) : stack(stack) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+      this->handle = handle;
+      return stack->popOrWait(this);
+    }
+
+    T await_resume() { return std::move(*value); }
+  };
+
+  class PushAwaiter {
+    friend class AsyncStack;
+    friend struct WaitQueue<PushAwaiter>;
+
+    AsyncStack *stack;
+    T value;
+    std::coroutine_handle<> handle;
+    PushAwaiter *next = nullptr;
+
+   public:
+    PushAwaiter(AsyncStack *stack, T value)
+        : stack(stack), value(std::move(value)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+      this->handle = handle;
+      return stack->pushOrWait(this);
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  AsyncStack(int capacity) : storage(capacity) {}
+
+  // Waiters point back at the stack, so it must stay where it is.
+  AsyncStack(const AsyncStack &other) = delete;
+  AsyncStack &operator=(const AsyncStack &other) = delete;
+
+  // Return and remove the top item, suspending while the stack is empty.
+  [[nodiscard]] PopAwaiter pop() { return PopAwaiter(this); }
+
+  // Suspend while the stack is full.
+  [[nodiscard]] PushAwaiter push(T value) {
+    return PushAwaiter(this, std::move(value));
+  }
+
+  int getCapacity() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return storage.getCapacity();
+  }
+
+  int getNumberOfElements() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return storage.getNumberOfElements();
+  }
+};
+
+#endif  // ASYNC_STACK_H
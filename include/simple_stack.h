@@ -1,8 +1,9 @@
+#include <cstddef>
+#include <cstdint>
 #include <exception>
-#include <iostream>
 #include <memory>
-#include <sstream>
 #include <string>
+#include <utility>
 
 #ifndef SIMPLE_STACK_H
 #define SIMPLE_STACK_H
@@ -45,7 +46,38 @@ class StackOverflowError : public std::exception {
   std::string message_;
 };
 
-bool isValidCapacity(int capacity) { return capacity > 0; }
+class StackInvalidMarkError : public std::exception {
+ public:
+  StackInvalidMarkError(const std::string &message) : message_(message) {}
+
+  virtual const char *what() const noexcept override {
+    return message_.c_str();
+  }
+
+ private:
+  std::string message_;
+};
+
+inline bool isValidCapacity(int capacity) { return capacity > 0; }
+
+////////////////////////////////////////////////////
+
+// A checkpoint returned by `Stack::mark()`. It only records the depth of the
+// stack, so marks nest naturally: rolling back to an outer mark also discards
+// everything pushed after any inner mark.
+struct StackMark {
+  int numberOfElements;
+};
+
+// When a `StackArray` gives the memory above its top back to the OS on its own,
+// see `StackArray::setShrinkPolicy()`. The default policy never does.
+struct StackShrinkPolicy {
+  // Shrink once the depth has stayed below this fraction of the high-water
+  // mark...
+  double fraction = 0;
+  // ...for this many consecutive pops. 0 disables the policy.
+  int numberOfPops = 0;
+};
 
 ////////////////////////////////////////////////////
 
@@ -62,6 +94,9 @@ class Stack {
   int numberOfElements = 0;
 
  public:
+  // Stacks are owned through `Stack<T>` pointers, e.g. by the C ABI.
+  virtual ~Stack() = default;
+
   virtual bool isFull() const = 0;
   virtual bool isEmpty() const = 0;
   virtual void push(T value) = 0;
@@ -70,91 +105,129 @@ class Stack {
   int getCapacity() const { return capacity; };
   virtual int getNumberOfElements() const = 0;
   virtual void clear() = 0;
+
+  StackMark mark() const { return StackMark{getNumberOfElements()}; }
+
+  // Discard every element pushed after `mark` was taken. Implementations
+  // override this to truncate in one step; the fallback pops one by one.
+  virtual void rollback(StackMark mark) {
+    checkMark(mark);
+    while (getNumberOfElements() > mark.numberOfElements) {
+      pop();
+    }
+  }
+
+ protected:
+  void checkMark(StackMark mark) const {
+    if (mark.numberOfElements < 0 ||
+        mark.numberOfElements > getNumberOfElements()) {
+      throw StackInvalidMarkError(
+          "You can't roll back to a mark above the top of the stack. The mark "
+          "is at " +
+          std::to_string(mark.numberOfElements) + ", the stack holds " +
+          std::to_string(getNumberOfElements()));
+    }
+  }
 };
 
+// Array implementation. The member functions that are not defined here are in
+// `simple_stack_impl.h`.
 template <class T>
 class StackArray : public Stack<T> {
   std::unique_ptr<T[]> array;
+  // Deepest the stack has been since construction or the last shrink. Slots
+  // above it have never been written to.
+  int highWaterMark = 0;
+  StackShrinkPolicy shrinkPolicy;
+  // Consecutive pops below `shrinkPolicy.fraction` of the high-water mark
+  int numberOfLowPops = 0;
+
+  // A thread is only worth starting for about this much copying.
+  static constexpr std::size_t kBytesPerCopyThread = std::size_t(8) << 20;
+  static constexpr double kSecondsPerCopyThread = 0.001;
+  // Elements that are not trivially copyable are copied on one thread below
+  // this count. Above it, the copy time is estimated from a first batch of at
+  // least this many elements, taking at least this long.
+  static constexpr int kMinElementsForCopyThreads = 16384;
+  static constexpr int kMinTimedCopyElements = 64;
+  static constexpr double kMinTimedCopySeconds = 10e-6;
+
+  // Default-initialised, so that for trivial types the pages are only touched
+  // once the stack actually grows into them.
+  static std::unique_ptr<T[]> allocate(int capacity);
+
+  // Let the OS reclaim the whole pages inside slots [first, last). The
+  // contents of those slots become unspecified, which is only fine for
+  // trivially copyable types: `push()` overwrites every byte.
+  void decommit(int first, int last);
+
+  // Copy from[0..count) to to[0..count) on up to `numberOfThreads` threads,
+  // the calling thread included. With 0 threads the number is picked from the
+  // size of the copy: by bytes for trivially copyable types, otherwise by
+  // timing the copy of a first batch. Elements are copied in disjoint
+  // ranges, so the first exception of any thread is rethrown after all of
+  // them have finished.
+  static void copyElements(const T *from, T *to, int count,
+                           int numberOfThreads);
+
+  // Copy `other` on `numberOfThreads` threads, see `copyElements()`.
+  StackArray(const StackArray &other, int numberOfThreads);
+
+  void applyShrinkPolicy();
 
  public:
-  StackArray(int capacity) {
-    if (!isValidCapacity(capacity)) {
-      throw StackInvalidCapacityError(
-          "Capacity must be greater than 0. You gave " +
-          std::to_string(capacity));
-    }
-    this->capacity = capacity;
-    array = std::make_unique<T[]>(capacity);
-  }
+  StackArray(int capacity);
 
-  // Copy constructor
-  StackArray(const StackArray &other) {
-    this->capacity = other.capacity;
-    this->numberOfElements = other.numberOfElements;
-    array = std::make_unique<T[]>(this->capacity);
-
-    for (int i = 0; i < this->numberOfElements; i++) {
-      array[i] = other.array[i];
-    }
-  }
+  // Copy constructor. Large copies are spread over several threads.
+  StackArray(const StackArray &other);
 
   // Copy assignment
-  StackArray &operator=(const StackArray &other) {
-    if (this != &other) {
-      clear();
-
-      // Create a temporary copy-object.
-      StackArray temp = other;
-      std::swap(this->capacity, temp.capacity);
-      std::swap(this->numberOfElements, temp.numberOfElements);
-      std::swap(this->array, temp.array);
-    }
-    return *this;
-  }
+  StackArray &operator=(const StackArray &other);
 
   // Move constructor
-  StackArray(StackArray &&other) noexcept {
-    this->numberOfElements = other.numberOfElements;
-    this->capacity = other.capacity;
-    array = std::move(other.array);
-
-    other.array = nullptr;
-    other.numberOfElements = 0;
-    other.capacity = 0;
-  }
+  StackArray(StackArray &&other) noexcept;
 
   // Move assignment
-  StackArray &operator=(StackArray &&other) noexcept {
-    if (this != &other) {
-      clear();
-
-      std::swap(this->capacity, other.capacity);
-      std::swap(this->numberOfElements, other.numberOfElements);
-      std::swap(this->array, other.array);
-    }
-    return *this;
+  StackArray &operator=(StackArray &&other) noexcept;
+
+  ~StackArray();
+
+  // Copy on `numberOfThreads` threads, e.g. for a few large elements that the
+  // copy constructor would not split up on its own.
+  StackArray cloneParallel(int numberOfThreads) const;
+
+  void clear() override;
+
+  // Remove every element but keep the capacity, so that unlike after
+  // `clear()` the stack can be used again. The memory is given back as in
+  // `shrinkToFit()`.
+  void reset();
+
+  // Give the memory above the top back to the OS. The capacity stays the
+  // same: a later push simply faults the pages in again.
+  //
+  // For trivially copyable types the whole pages above the top are
+  // decommitted with `madvise(MADV_DONTNEED)`. Other types keep their slots,
+  // which are reset to `T()` so that they release what they own.
+  void shrinkToFit();
+
+  // Shrink automatically once the depth has stayed below
+  // `policy.fraction * getHighWaterMark()` for `policy.numberOfPops`
+  // consecutive pops, e.g. {0.25, 1000}.
+  void setShrinkPolicy(StackShrinkPolicy policy) {
+    shrinkPolicy = policy;
+    numberOfLowPops = 0;
   }
 
-  ~StackArray() { clear(); }
+  StackShrinkPolicy getShrinkPolicy() const { return shrinkPolicy; }
 
-  void clear() override {
-    while (isEmpty() == false) {
-      pop();
-    }
-    // delete[] array;
-    array = nullptr;
-    this->capacity = 0;
-  }
+  // Deepest the stack has been since construction or the last shrink
+  int getHighWaterMark() const { return highWaterMark; }
 
-  void display() {
-    std::stringstream ss;
-    for (int i = 0; i < this->numberOfElements; i++) {
-      ss << array[i] << " ";
-    }
-    std::cout << "Stack (numberOfElements: " << this->capacity
-              << "): " << (ss.str()) << std::endl;
-  }
+  void display();
 
+  // The element accessors stay here, so that they can still be inlined
+  // where the element type is instantiated in the library.
   bool isEmpty() const override { return this->getNumberOfElements() == 0; }
 
   bool isFull() const override {
@@ -175,6 +248,9 @@ class StackArray : public Stack<T> {
     }
     T value = array[this->numberOfElements - 1];  // FIXME: This is
     this->numberOfElements--;
+    if (shrinkPolicy.numberOfPops > 0) {
+      applyShrinkPolicy();
+    }
     return value;
   }
 
@@ -188,9 +264,14 @@ class StackArray : public Stack<T> {
     }
     array[this->numberOfElements] = value;
     this->numberOfElements++;
+    if (this->numberOfElements > highWaterMark) {
+      highWaterMark = this->numberOfElements;
+    }
   }
   int getNumberOfElements() const override { return this->numberOfElements; }
 
+  void rollback(StackMark mark) override;
+
   T *getArray() const { return array.get(); }
 };
 
@@ -205,94 +286,37 @@ class Node {
   Node(T value) : value(value) {}
 };
 
-// Singly linked list implementation
+// Singly linked list implementation. The member functions that are not
+// defined here are in `simple_stack_impl.h`.
 template <class T>
 class StackLinkedList : public Stack<T> {
   // Holds the latest/top item in a stack.
   std::unique_ptr<Node<T>> top;
 
  public:
-  StackLinkedList(int capacity) {
-    if (!isValidCapacity(capacity)) {
-      throw StackInvalidCapacityError(
-          "Capacity must be greater than 0. You gave " +
-          std::to_string(capacity));
-    }
-    this->capacity = capacity;
-  }
+  StackLinkedList(int capacity);
 
   // Copy constructor
-  StackLinkedList(const StackLinkedList &other) {
-    this->capacity = other.capacity;
-    if (other.isEmpty() == true) {
-      return;
-    }
-    // First, copy the top.
-    Node<T> *otherNode = other.top.get();
-    top = std::make_unique<Node<T>>(otherNode->value);
-    this->numberOfElements++;
-
-    // Then, copy the remaining nodes in the same sequence.
-    Node<T> *thisNode = top.get();
-    otherNode = otherNode->next.get();
-    while (otherNode != nullptr) {
-      thisNode->next = std::make_unique<Node<T>>(otherNode->value);
-      thisNode = thisNode->next.get();
-      otherNode = otherNode->next.get();
-      this->numberOfElements++;
-    }
-  }
+  StackLinkedList(const StackLinkedList &other);
 
   // Copy assignment operator
-  StackLinkedList &operator=(const StackLinkedList &other) {
-    if (this != &other) {
-      // Delete data associated with this
-      clear();
-
-      // Create a temporary copy-object
-      StackLinkedList temp = other;
-      // Transfer ownership of the copy-object's resources to this
-      // This approach minimizes the risk of memory leaks
-      std::swap(this->capacity, temp.capacity);
-      std::swap(this->numberOfElements, temp.numberOfElements);
-      std::swap(top, temp.top);
-    }
-    return *this;
-  }
+  StackLinkedList &operator=(const StackLinkedList &other);
 
   // Move constructor
-  StackLinkedList(StackLinkedList &&other) noexcept {
-    this->capacity = other.capacity;
-    this->numberOfElements = other.numberOfElements;
-    top = std::move(other.top);
-
-    other.capacity = 0;
-    other.numberOfElements = 0;
-    other.top = nullptr;
-  }
+  StackLinkedList(StackLinkedList &&other) noexcept;
 
   // Move assignment operator
-  StackLinkedList &operator=(StackLinkedList &&other) noexcept {
-    if (this != &other) {
-      clear();
-
-      std::swap(this->capacity, other.capacity);
-      std::swap(this->numberOfElements, other.numberOfElements);
-      std::swap(top, other.top);
-    }
-    return *this;
-  }
+  StackLinkedList &operator=(StackLinkedList &&other) noexcept;
 
-  ~StackLinkedList() { clear(); }
+  ~StackLinkedList();
 
   // Empty every member of the instance. Used for move assignment/constructor
   // and destructor.
-  void clear() override {
-    while (isEmpty() == false) {
-      pop();
-    }
-    this->capacity = 0;
-  }
+  void clear() override;
+
+  // Remove every node but keep the capacity, so that unlike after `clear()`
+  // the stack can be used again.
+  void reset() { rollback(StackMark{0}); }
 
   // Return the number of nodes in a stack
   int getNumberOfElements() const override { return this->numberOfElements; }
@@ -336,7 +360,35 @@ class StackLinkedList : public Stack<T> {
     this->numberOfElements++;
   }
 
+  void rollback(StackMark mark) override;
+
   Node<T> *getTop() const { return top.get(); }
 };
 
+#include "simple_stack_impl.h"
+
+// The stacks for the most common element types are instantiated once in
+// `src/simple_stack_<type>.cpp`, so code using them does not compile them
+// again but has to link the `simple_stack` library. Define
+// SIMPLE_STACK_HEADER_ONLY to instantiate them in place instead.
+#ifndef SIMPLE_STACK_HEADER_ONLY
+extern template class Stack<int>;
+extern template class Stack<std::int64_t>;
+extern template class Stack<double>;
+extern template class Stack<char>;
+extern template class Stack<std::string>;
+
+extern template class StackArray<int>;
+extern template class StackArray<std::int64_t>;
+extern template class StackArray<double>;
+extern template class StackArray<char>;
+extern template class StackArray<std::string>;
+
+extern template class StackLinkedList<int>;
+extern template class StackLinkedList<std::int64_t>;
+extern template class StackLinkedList<double>;
+extern template class StackLinkedList<char>;
+extern template class StackLinkedList<std::string>;
+#endif
+
 #endif  // SIMPLE_STACK_H
@@ -0,0 +1,111 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef SIMPLE_STACK_C_H
+#define SIMPLE_STACK_C_H
+
+// C ABI of the `simple_stack` library for concrete element types, so that the
+// stacks can be used from C and through FFIs such as Python's `ctypes` (see
+// `native_stack.py`).
+//
+// Every function returns one of the `simple_stack_status` codes instead of
+// throwing. A function that fails leaves the stack unchanged; in particular
+// the `*_many` calls push or pop either all `count` elements or none.
+// `*_pop_many` writes the popped elements in pop order, i.e. top first.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum simple_stack_status {
+  SIMPLE_STACK_OK = 0,
+  // `StackInvalidCapacityError`
+  SIMPLE_STACK_INVALID_CAPACITY = 1,
+  // `StackUnderflowError`
+  SIMPLE_STACK_UNDERFLOW = 2,
+  // `StackOverflowError`
+  SIMPLE_STACK_OVERFLOW = 3,
+  SIMPLE_STACK_OUT_OF_MEMORY = 4,
+  // The output buffer of a bytes pop is too small. The required size is
+  // reported and nothing is popped.
+  SIMPLE_STACK_BUFFER_TOO_SMALL = 5,
+  SIMPLE_STACK_INVALID_ARGUMENT = 6,
+  SIMPLE_STACK_ERROR = 7
+} simple_stack_status;
+
+typedef enum simple_stack_kind {
+  // `StackArray`
+  SIMPLE_STACK_ARRAY = 0,
+  // `StackLinkedList`
+  SIMPLE_STACK_LINKED_LIST = 1
+} simple_stack_kind;
+
+////////////////////////////////////////////////////
+// int64_t
+typedef struct simple_stack_int64 simple_stack_int64;
+
+int simple_stack_int64_create(int kind, int capacity,
+                              simple_stack_int64 **stack);
+int simple_stack_int64_copy(const simple_stack_int64 *other,
+                            simple_stack_int64 **stack);
+void simple_stack_int64_destroy(simple_stack_int64 *stack);
+int simple_stack_int64_capacity(const simple_stack_int64 *stack);
+int simple_stack_int64_size(const simple_stack_int64 *stack);
+int simple_stack_int64_push(simple_stack_int64 *stack, int64_t value);
+int simple_stack_int64_pop(simple_stack_int64 *stack, int64_t *value);
+int simple_stack_int64_push_many(simple_stack_int64 *stack,
+                                 const int64_t *values, int count);
+int simple_stack_int64_pop_many(simple_stack_int64 *stack, int64_t *values,
+                                int count);
+
+////////////////////////////////////////////////////
+// double
+typedef struct simple_stack_double simple_stack_double;
+
+int simple_stack_double_create(int kind, int capacity,
+                               simple_stack_double **stack);
+int simple_stack_double_copy(const simple_stack_double *other,
+                             simple_stack_double **stack);
+void simple_stack_double_destroy(simple_stack_double *stack);
+int simple_stack_double_capacity(const simple_stack_double *stack);
+int simple_stack_double_size(const simple_stack_double *stack);
+int simple_stack_double_push(simple_stack_double *stack, double value);
+int simple_stack_double_pop(simple_stack_double *stack, double *value);
+int simple_stack_double_push_many(simple_stack_double *stack,
+                                  const double *values, int count);
+int simple_stack_double_pop_many(simple_stack_double *stack, double *values,
+                                 int count);
+
+////////////////////////////////////////////////////
+// Byte strings. Each element is an arbitrary run of bytes, copied in on push.
+typedef struct simple_stack_bytes simple_stack_bytes;
+
+int simple_stack_bytes_create(int kind, int capacity,
+                              simple_stack_bytes **stack);
+int simple_stack_bytes_copy(const simple_stack_bytes *other,
+                            simple_stack_bytes **stack);
+void simple_stack_bytes_destroy(simple_stack_bytes *stack);
+int simple_stack_bytes_capacity(const simple_stack_bytes *stack);
+int simple_stack_bytes_size(const simple_stack_bytes *stack);
+int simple_stack_bytes_push(simple_stack_bytes *stack, const char *data,
+                            size_t size);
+// Copy the top element into `buffer` and pop it. `*size` receives its size,
+// also when `SIMPLE_STACK_BUFFER_TOO_SMALL` is returned.
+int simple_stack_bytes_pop(simple_stack_bytes *stack, char *buffer,
+                           size_t bufferSize, size_t *size);
+// Element `i` is `data[i]` of `sizes[i]` bytes.
+int simple_stack_bytes_push_many(simple_stack_bytes *stack,
+                                 const char *const *data, const size_t *sizes,
+                                 int count);
+// The popped elements are written back to back into `buffer` and their sizes
+// into `sizes`. `*totalSize` receives the number of bytes needed, also when
+// `SIMPLE_STACK_BUFFER_TOO_SMALL` is returned.
+int simple_stack_bytes_pop_many(simple_stack_bytes *stack, char *buffer,
+                                size_t bufferSize, size_t *sizes, int count,
+                                size_t *totalSize);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // SIMPLE_STACK_C_H
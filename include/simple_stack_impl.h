@@ -0,0 +1,389 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Member definitions of the stacks declared in `simple_stack.h`, which
+// includes this file. Do not include it on its own.
+#ifndef SIMPLE_STACK_IMPL_H
+#define SIMPLE_STACK_IMPL_H
+
+////////////////////////////////////////////////////
+// StackArray
+template <class T>
+std::unique_ptr<T[]> StackArray<T>::allocate(int capacity) {
+  return std::unique_ptr<T[]>(new T[capacity]);
+}
+
+template <class T>
+void StackArray<T>::decommit(int first, int last) {
+#if defined(MADV_DONTNEED)
+  static const std::uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+  std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(array.get() + first);
+  std::uintptr_t end = reinterpret_cast<std::uintptr_t>(array.get() + last);
+  begin = (begin + pageSize - 1) / pageSize * pageSize;
+  end = end / pageSize * pageSize;
+  if (begin < end) {
+    madvise(reinterpret_cast<void *>(begin), end - begin, MADV_DONTNEED);
+  }
+#else
+  (void)first;
+  (void)last;
+#endif
+}
+
+template <class T>
+void StackArray<T>::copyElements(const T *from, T *to, int count,
+                                 int numberOfThreads) {
+  int first = 0;
+  if (numberOfThreads == 0) {
+    double numberOfThreadsWorthIt = 1;
+    if (std::is_trivially_copyable<T>::value) {
+      numberOfThreadsWorthIt =
+          static_cast<double>(sizeof(T)) * count / kBytesPerCopyThread;
+    } else if (count >= kMinElementsForCopyThreads) {
+      // A single copy is too short to time reliably, so time a batch.
+      std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+      std::chrono::duration<double> elapsed;
+      do {
+        int end = std::min(count, first + kMinTimedCopyElements);
+        std::copy(from + first, from + end, to + first);
+        first = end;
+        elapsed = std::chrono::steady_clock::now() - start;
+      } while (first < count && elapsed.count() < kMinTimedCopySeconds);
+      numberOfThreadsWorthIt =
+          elapsed.count() / first * (count - first) / kSecondsPerCopyThread;
+    }
+    int numberOfCores =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    numberOfThreads = static_cast<int>(std::min<double>(
+        numberOfCores, std::max(1.0, numberOfThreadsWorthIt)));
+  }
+  numberOfThreads = std::min(numberOfThreads, count - first);
+  if (numberOfThreads <= 1) {
+    std::copy(from + first, from + count, to + first);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(numberOfThreads);
+  std::vector<std::thread> workers;
+  workers.reserve(numberOfThreads - 1);
+  long long numberOfElements = count - first;
+  for (int t = 0; t < numberOfThreads; t++) {
+    int begin =
+        first + static_cast<int>(numberOfElements * t / numberOfThreads);
+    int end =
+        first + static_cast<int>(numberOfElements * (t + 1) / numberOfThreads);
+    auto work = [from, to, begin, end, t, &errors] {
+      try {
+        std::copy(from + begin, from + end, to + begin);
+      } catch (...) {
+        errors[t] = std::current_exception();
+      }
+    };
+    if (t == numberOfThreads - 1) {
+      work();
+    } else {
+      try {
+        workers.emplace_back(work);
+      } catch (const std::system_error &) {
+        // Out of threads: copy this range here instead.
+        work();
+      }
+    }
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  for (std::exception_ptr &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+template <class T>
+StackArray<T>::StackArray(const StackArray &other, int numberOfThreads) {
+  this->capacity = other.capacity;
+  highWaterMark = other.numberOfElements;
+  shrinkPolicy = other.shrinkPolicy;
+  array = allocate(this->capacity);
+
+  copyElements(other.array.get(), array.get(), other.numberOfElements,
+               numberOfThreads);
+  this->numberOfElements = other.numberOfElements;
+}
+
+template <class T>
+void StackArray<T>::applyShrinkPolicy() {
+  if (this->numberOfElements < shrinkPolicy.fraction * highWaterMark) {
+    if (++numberOfLowPops >= shrinkPolicy.numberOfPops) {
+      shrinkToFit();
+    }
+  } else {
+    numberOfLowPops = 0;
+  }
+}
+
+template <class T>
+StackArray<T>::StackArray(int capacity) {
+  if (!isValidCapacity(capacity)) {
+    throw StackInvalidCapacityError(
+        "Capacity must be greater than 0. You gave " +
+        std::to_string(capacity));
+  }
+  this->capacity = capacity;
+  array = allocate(capacity);
+}
+
+template <class T>
+StackArray<T>::StackArray(const StackArray &other) : StackArray(other, 0) {}
+
+template <class T>
+StackArray<T> &StackArray<T>::operator=(const StackArray &other) {
+  if (this != &other) {
+    // Trivially copyable elements can be copied straight into the storage we
+    // already have, without a temporary. Copying them cannot throw.
+    if (std::is_trivially_copyable<T>::value && array != nullptr &&
+        this->capacity == other.capacity) {
+      copyElements(other.array.get(), array.get(), other.numberOfElements, 0);
+      this->numberOfElements = other.numberOfElements;
+      highWaterMark = std::max(highWaterMark, other.numberOfElements);
+      shrinkPolicy = other.shrinkPolicy;
+      numberOfLowPops = 0;
+      return *this;
+    }
+
+    // Copy into a temporary first, so that `*this` is left untouched if
+    // copying throws. `temp` then frees our old elements.
+    StackArray temp = other;
+    std::swap(this->capacity, temp.capacity);
+    std::swap(this->numberOfElements, temp.numberOfElements);
+    std::swap(this->array, temp.array);
+    std::swap(highWaterMark, temp.highWaterMark);
+    std::swap(shrinkPolicy, temp.shrinkPolicy);
+    std::swap(numberOfLowPops, temp.numberOfLowPops);
+  }
+  return *this;
+}
+
+template <class T>
+StackArray<T>::StackArray(StackArray &&other) noexcept {
+  this->numberOfElements = other.numberOfElements;
+  this->capacity = other.capacity;
+  array = std::move(other.array);
+  highWaterMark = other.highWaterMark;
+  shrinkPolicy = other.shrinkPolicy;
+  numberOfLowPops = other.numberOfLowPops;
+
+  other.array = nullptr;
+  other.numberOfElements = 0;
+  other.capacity = 0;
+  other.highWaterMark = 0;
+  other.numberOfLowPops = 0;
+}
+
+template <class T>
+StackArray<T> &StackArray<T>::operator=(StackArray &&other) noexcept {
+  if (this != &other) {
+    clear();
+
+    std::swap(this->capacity, other.capacity);
+    std::swap(this->numberOfElements, other.numberOfElements);
+    std::swap(this->array, other.array);
+    std::swap(highWaterMark, other.highWaterMark);
+    std::swap(shrinkPolicy, other.shrinkPolicy);
+    std::swap(numberOfLowPops, other.numberOfLowPops);
+  }
+  return *this;
+}
+
+template <class T>
+StackArray<T>::~StackArray() {
+  clear();
+}
+
+template <class T>
+StackArray<T> StackArray<T>::cloneParallel(int numberOfThreads) const {
+  if (numberOfThreads <= 0) {
+    throw std::invalid_argument(
+        "Number of threads must be greater than 0. You gave " +
+        std::to_string(numberOfThreads));
+  }
+  return StackArray(*this, numberOfThreads);
+}
+
+template <class T>
+void StackArray<T>::clear() {
+  // Drop the elements in one go: releasing `array` destroys every slot. Popping
+  // them would copy each one out and apply the shrink policy on the way.
+  this->numberOfElements = 0;
+  array = nullptr;
+  this->capacity = 0;
+  highWaterMark = 0;
+  numberOfLowPops = 0;
+}
+
+template <class T>
+void StackArray<T>::reset() {
+  rollback(StackMark{0});
+  shrinkToFit();
+}
+
+template <class T>
+void StackArray<T>::shrinkToFit() {
+  if (std::is_trivially_copyable<T>::value) {
+    decommit(this->numberOfElements, highWaterMark);
+  } else {
+    for (int i = this->numberOfElements; i < highWaterMark; i++) {
+      array[i] = T();
+    }
+  }
+  highWaterMark = this->numberOfElements;
+  numberOfLowPops = 0;
+}
+
+template <class T>
+void StackArray<T>::display() {
+  std::stringstream ss;
+  for (int i = 0; i < this->numberOfElements; i++) {
+    ss << array[i] << " ";
+  }
+  std::cout << "Stack (numberOfElements: " << this->capacity
+            << "): " << (ss.str()) << std::endl;
+}
+
+template <class T>
+void StackArray<T>::rollback(StackMark mark) {
+  this->checkMark(mark);
+  // Trivially destructible values are simply left behind like in `pop()`.
+  // Others are reset so that they release what they own right away.
+  if (!std::is_trivially_destructible<T>::value) {
+    for (int i = mark.numberOfElements; i < this->numberOfElements; i++) {
+      array[i] = T();
+    }
+  }
+  this->numberOfElements = mark.numberOfElements;
+  if (shrinkPolicy.numberOfPops > 0) {
+    applyShrinkPolicy();
+  }
+}
+
+////////////////////////////////////////////////////
+// StackLinkedList
+template <class T>
+StackLinkedList<T>::StackLinkedList(int capacity) {
+  if (!isValidCapacity(capacity)) {
+    throw StackInvalidCapacityError(
+        "Capacity must be greater than 0. You gave " +
+        std::to_string(capacity));
+  }
+  this->capacity = capacity;
+}
+
+template <class T>
+StackLinkedList<T>::StackLinkedList(const StackLinkedList &other) {
+  this->capacity = other.capacity;
+  if (other.isEmpty() == true) {
+    return;
+  }
+  // First, copy the top.
+  Node<T> *otherNode = other.top.get();
+  top = std::make_unique<Node<T>>(otherNode->value);
+  this->numberOfElements++;
+
+  // Then, copy the remaining nodes in the same sequence.
+  Node<T> *thisNode = top.get();
+  otherNode = otherNode->next.get();
+  while (otherNode != nullptr) {
+    thisNode->next = std::make_unique<Node<T>>(otherNode->value);
+    thisNode = thisNode->next.get();
+    otherNode = otherNode->next.get();
+    this->numberOfElements++;
+  }
+}
+
+template <class T>
+StackLinkedList<T> &StackLinkedList<T>::operator=(
+    const StackLinkedList &other) {
+  if (this != &other) {
+    // Delete data associated with this
+    clear();
+
+    // Create a temporary copy-object
+    StackLinkedList temp = other;
+    // Transfer ownership of the copy-object's resources to this
+    // This approach minimizes the risk of memory leaks
+    std::swap(this->capacity, temp.capacity);
+    std::swap(this->numberOfElements, temp.numberOfElements);
+    std::swap(top, temp.top);
+  }
+  return *this;
+}
+
+template <class T>
+StackLinkedList<T>::StackLinkedList(StackLinkedList &&other) noexcept {
+  this->capacity = other.capacity;
+  this->numberOfElements = other.numberOfElements;
+  top = std::move(other.top);
+
+  other.capacity = 0;
+  other.numberOfElements = 0;
+  other.top = nullptr;
+}
+
+template <class T>
+StackLinkedList<T> &StackLinkedList<T>::operator=(
+    StackLinkedList &&other) noexcept {
+  if (this != &other) {
+    clear();
+
+    std::swap(this->capacity, other.capacity);
+    std::swap(this->numberOfElements, other.numberOfElements);
+    std::swap(top, other.top);
+  }
+  return *this;
+}
+
+template <class T>
+StackLinkedList<T>::~StackLinkedList() {
+  clear();
+}
+
+template <class T>
+void StackLinkedList<T>::clear() {
+  while (isEmpty() == false) {
+    pop();
+  }
+  this->capacity = 0;
+}
+
+template <class T>
+void StackLinkedList<T>::rollback(StackMark mark) {
+  this->checkMark(mark);
+  // Unlink the nodes without copying their values out. This is done one node
+  // at a time because destroying a long `unique_ptr` chain at once would
+  // recurse once per node.
+  while (this->numberOfElements > mark.numberOfElements) {
+    top = std::move(top->next);
+    this->numberOfElements--;
+  }
+}
+
+#endif  // SIMPLE_STACK_IMPL_H
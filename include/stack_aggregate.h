@@ -0,0 +1,157 @@
+#include <string>
+#include <utility>
+
+#include "simple_stack.h"
+
+#ifndef STACK_AGGREGATE_H
+#define STACK_AGGREGATE_H
+
+////////////////////////////////////////////////////
+// Aggregates. Any associative binary operation works; no identity element is
+// needed because the aggregate of an empty stack is an error.
+template <class T>
+struct MinAggregate {
+  T operator()(const T &below, const T &value) const {
+    return value < below ? value : below;
+  }
+};
+
+template <class T>
+struct MaxAggregate {
+  T operator()(const T &below, const T &value) const {
+    return below < value ? value : below;
+  }
+};
+
+template <class T>
+struct SumAggregate {
+  T operator()(const T &below, const T &value) const { return below + value; }
+};
+
+////////////////////////////////////////////////////
+
+// One slot of `StackAggregate`: the value and the aggregate of everything up
+// to and including it, stored side by side so a push or pop touches one cache
+// line instead of two parallel arrays.
+template <class T>
+struct AggregateEntry {
+  T value;
+  T aggregate;
+};
+
+// A `StackArray` that also answers "what is the min/max/sum/... of everything
+// on the stack" in O(1). `Combine` is called as `combine(belowAggregate,
+// value)`.
+template <class T, class Combine = MinAggregate<T>>
+class StackAggregate : public Stack<T> {
+  StackArray<AggregateEntry<T>> entries;
+  Combine combine;
+
+ public:
+  StackAggregate(int capacity, Combine combine = Combine())
+      : entries(capacity), combine(combine) {
+    this->capacity = capacity;
+  }
+
+  // Copy constructor/assignment are member-wise.
+  StackAggregate(const StackAggregate &other) = default;
+  StackAggregate &operator=(const StackAggregate &other) = default;
+
+  // Move constructor
+  StackAggregate(StackAggregate &&other) noexcept
+      : entries(std::move(other.entries)), combine(std::move(other.combine)) {
+    this->capacity = other.capacity;
+    other.capacity = 0;
+  }
+
+  // Move assignment
+  StackAggregate &operator=(StackAggregate &&other) noexcept {
+    if (this != &other) {
+      clear();
+
+      std::swap(this->capacity, other.capacity);
+      std::swap(entries, other.entries);
+      std::swap(combine, other.combine);
+    }
+    return *this;
+  }
+
+  void clear() override {
+    entries.clear();
+    this->capacity = 0;
+  }
+
+  bool isEmpty() const override { return entries.isEmpty(); }
+
+  bool isFull() const override { return entries.isFull(); }
+
+  int getNumberOfElements() const override {
+    return entries.getNumberOfElements();
+  }
+
+  T peek() override {
+    if (isEmpty()) {
+      throw StackUnderflowError("You can't peek an empty stack.");
+    }
+    return getTopEntry().value;
+  }
+
+  // Return and remove the top item
+  T pop() override {
+    if (isEmpty()) {
+      throw StackUnderflowError("You can't pop an empty stack.");
+    }
+    return entries.pop().value;
+  }
+
+  void push(T value) override {
+    if (isFull()) {
+      throw StackOverflowError(
+          "Stack Overflow: You can't push to a full stack. The "
+          "numberOfElements of the "
+          "stack is " +
+          std::to_string(this->capacity));
+    }
+    T aggregate = isEmpty() ? value : combine(getTopEntry().aggregate, value);
+    entries.push(AggregateEntry<T>{std::move(value), std::move(aggregate)});
+  }
+
+  void rollback(StackMark mark) override { entries.rollback(mark); }
+
+  // Aggregate of every element currently on the stack
+  T getAggregate() const {
+    if (isEmpty()) {
+      throw StackUnderflowError(
+          "You can't get the aggregate of an empty stack.");
+    }
+    return getTopEntry().aggregate;
+  }
+
+ private:
+  const AggregateEntry<T> &getTopEntry() const {
+    return entries.getArray()[entries.getNumberOfElements() - 1];
+  }
+};
+
+template <class T>
+class StackMin : public StackAggregate<T, MinAggregate<T>> {
+ public:
+  using StackAggregate<T, MinAggregate<T>>::StackAggregate;
+  T getMin() const { return this->getAggregate(); }
+};
+
+template <class T>
+class StackMax : public StackAggregate<T, MaxAggregate<T>> {
+ public:
+  using StackAggregate<T, MaxAggregate<T>>::StackAggregate;
+  T getMax() const { return this->getAggregate(); }
+};
+
+template <class T>
+class StackSum : public StackAggregate<T, SumAggregate<T>> {
+ public:
+  using StackAggregate<T, SumAggregate<T>>::StackAggregate;
+  T getSum() const { return this->getAggregate(); }
+};
+
+#endif  // STACK_AGGREGATE_H
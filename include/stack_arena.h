@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "simple_stack.h"
+
+#ifndef STACK_ARENA_H
+#define STACK_ARENA_H
+
+template <class T>
+class StackArena;
+
+// A handle to one logical stack inside a `StackArena`. It is cheap to copy and
+// only valid while the arena that handed it out is alive.
+template <class T>
+class ArenaStack : public Stack<T> {
+  StackArena<T> *arena;
+  int index;
+
+ public:
+  ArenaStack(StackArena<T> *arena, int index) : arena(arena), index(index) {
+    // A single stack may grow until it owns the whole arena.
+    this->capacity = arena->getCapacity();
+  }
+
+  bool isFull() const override { return arena->isFull(); }
+
+  bool isEmpty() const override { return getNumberOfElements() == 0; }
+
+  void push(T value) override { arena->push(index, std::move(value)); }
+
+  T pop() override { return arena->pop(index); }
+
+  T peek() override { return arena->peek(index); }
+
+  int getNumberOfElements() const override {
+    return arena->getNumberOfElements(index);
+  }
+
+  // Empty this stack only. The slots stay in the arena for the other stacks.
+  void clear() override { arena->clear(index); }
+
+  void rollback(StackMark mark) override {
+    this->checkMark(mark);
+    arena->rollback(index, mark.numberOfElements);
+  }
+
+  int getIndex() const { return index; }
+};
+
+// Many logical stacks carved out of one contiguous buffer.
+//
+// Every stack owns a region [base, limit) of the buffer and grows upwards
+// inside it. When a stack hits the end of its region while the arena still has
+// free slots, the regions are repacked instead of throwing
+// `StackOverflowError`: a tenth of the free space is shared equally and the
+// rest goes to the stacks that grew since the last repack (Garwick's
+// reallocation, Knuth TAOCP Vol. 1, 2.2.2). Only a completely full arena
+// throws.
+template <class T>
+class StackArena {
+  struct Region {
+    int base;
+    int limit;
+    int numberOfElements;
+    // Used to find out which stacks grew since the last repack.
+    int numberOfElementsAtLastRepack;
+  };
+
+  std::unique_ptr<T[]> buffer;
+  std::vector<Region> regions;
+  int capacity;
+  int numberOfElements = 0;
+  int numberOfRepacks = 0;
+
+  Region &getRegion(int index) {
+    if (index < 0 || index >= getNumberOfStacks()) {
+      throw std::out_of_range("Stack index " + std::to_string(index) +
+                              " is out of range. The arena has " +
+                              std::to_string(getNumberOfStacks()) + " stacks.");
+    }
+    return regions[index];
+  }
+
+  const Region &getRegion(int index) const {
+    return const_cast<StackArena *>(this)->getRegion(index);
+  }
+
+  // Redistribute the free slots so that the stack `overflowing` has room for
+  // one more element. The caller guarantees that the arena is not full.
+  void repack(int overflowing) {
+    int n = getNumberOfStacks();
+    // The pending push is counted as if it had already happened.
+    int freeSlots = capacity - numberOfElements - 1;
+
+    long long totalGrowth = 0;
+    std::vector<int> growth(n);
+    for (int j = 0; j < n; j++) {
+      int size = regions[j].numberOfElements + (j == overflowing ? 1 : 0);
+      growth[j] = std::max(0, size - regions[j].numberOfElementsAtLastRepack);
+      totalGrowth += growth[j];
+    }
+
+    double equalShare = 0.1 * freeSlots / n;
+    double growthShare = 0.9 * freeSlots / totalGrowth;
+
+    std::vector<int> newBase(n);
+    newBase[0] = 0;
+    double sigma = 0;
+    for (int j = 1; j < n; j++) {
+      double tau = sigma + equalShare + growth[j - 1] * growthShare;
+      int size = regions[j - 1].numberOfElements +
+                 (j - 1 == overflowing ? 1 : 0);
+      newBase[j] = newBase[j - 1] + size +
+                   static_cast<int>(std::floor(tau) - std::floor(sigma));
+      sigma = tau;
+    }
+
+    // Stacks moving down are shifted bottom-up in ascending order, stacks
+    // moving up top-down in descending order, so no live element is
+    // overwritten before it has been moved.
+    for (int j = 0; j < n; j++) {
+      Region &region = regions[j];
+      if (newBase[j] < region.base) {
+        for (int k = 0; k < region.numberOfElements; k++) {
+          buffer[newBase[j] + k] = std::move(buffer[region.base + k]);
+        }
+      }
+    }
+    for (int j = n - 1; j >= 0; j--) {
+      Region &region = regions[j];
+      if (newBase[j] > region.base) {
+        for (int k = region.numberOfElements - 1; k >= 0; k--) {
+          buffer[newBase[j] + k] = std::move(buffer[region.base + k]);
+        }
+      }
+    }
+
+    for (int j = 0; j < n; j++) {
+      regions[j].base = newBase[j];
+      regions[j].limit = j + 1 < n ? newBase[j + 1] : capacity;
+      regions[j].numberOfElementsAtLastRepack = regions[j].numberOfElements;
+    }
+    numberOfRepacks++;
+  }
+
+ public:
+  StackArena(int capacity, int numberOfStacks) {
+    if (!isValidCapacity(capacity)) {
+      throw StackInvalidCapacityError(
+          "Capacity must be greater than 0. You gave " +
+          std::to_string(capacity));
+    }
+    if (numberOfStacks <= 0) {
+      throw StackInvalidCapacityError(
+          "Number of stacks must be greater than 0. You gave " +
+          std::to_string(numberOfStacks));
+    }
+    this->capacity = capacity;
+    buffer = std::make_unique<T[]>(capacity);
+
+    // Start with equally sized regions.
+    regions.resize(numberOfStacks);
+    for (int j = 0; j < numberOfStacks; j++) {
+      regions[j].base =
+          static_cast<int>(static_cast<long long>(capacity) * j /
+                           numberOfStacks);
+      regions[j].numberOfElements = 0;
+      regions[j].numberOfElementsAtLastRepack = 0;
+    }
+    for (int j = 0; j < numberOfStacks; j++) {
+      regions[j].limit =
+          j + 1 < numberOfStacks ? regions[j + 1].base : capacity;
+    }
+  }
+
+  // Handles keep a pointer to the arena, so it must stay where it is.
+  StackArena(const StackArena &other) = delete;
+  StackArena &operator=(const StackArena &other) = delete;
+  StackArena(StackArena &&other) = delete;
+  StackArena &operator=(StackArena &&other) = delete;
+
+  ArenaStack<T> getStack(int index) {
+    getRegion(index);
+    return ArenaStack<T>(this, index);
+  }
+
+  void push(int index, T value) {
+    Region &region = getRegion(index);
+    if (isFull()) {
+      throw StackOverflowError(
+          "Stack Overflow: You can't push to a full stack arena. The capacity "
+          "of the arena is " +
+          std::to_string(capacity));
+    }
+    if (region.base + region.numberOfElements == region.limit) {
+      repack(index);
+    }
+    buffer[region.base + region.numberOfElements] = std::move(value);
+    region.numberOfElements++;
+    numberOfElements++;
+  }
+
+  // Return and remove the top item of the stack `index`
+  T pop(int index) {
+    Region &region = getRegion(index);
+    if (region.numberOfElements == 0) {
+      throw StackUnderflowError("You can't pop an empty stack.");
+    }
+    region.numberOfElements--;
+    numberOfElements--;
+    return std::move(buffer[region.base + region.numberOfElements]);
+  }
+
+  T peek(int index) {
+    Region &region = getRegion(index);
+    if (region.numberOfElements == 0) {
+      throw StackUnderflowError("You can't peek an empty stack.");
+    }
+    return buffer[region.base + region.numberOfElements - 1];
+  }
+
+  // Truncate the stack `index` to its bottom `numberOfElementsLeft` elements
+  // in one step, like `StackArray::rollback()`.
+  void rollback(int index, int numberOfElementsLeft) {
+    Region &region = getRegion(index);
+    if (numberOfElementsLeft < 0 ||
+        numberOfElementsLeft > region.numberOfElements) {
+      throw std::out_of_range(
+          "Can't truncate stack " + std::to_string(index) + " to " +
+          std::to_string(numberOfElementsLeft) + " elements. It holds " +
+          std::to_string(region.numberOfElements));
+    }
+    // Reset the dropped slots so that they release what they own right away.
+    if (!std::is_trivially_destructible<T>::value) {
+      for (int k = numberOfElementsLeft; k < region.numberOfElements; k++) {
+        buffer[region.base + k] = T();
+      }
+    }
+    numberOfElements -= region.numberOfElements - numberOfElementsLeft;
+    region.numberOfElements = numberOfElementsLeft;
+  }
+
+  // Empty the stack `index`.
+  void clear(int index) { rollback(index, 0); }
+
+  bool isFull() const { return numberOfElements == capacity; }
+
+  bool isEmpty() const { return numberOfElements == 0; }
+
+  int getCapacity() const { return capacity; }
+
+  int getNumberOfStacks() const { return static_cast<int>(regions.size()); }
+
+  // Total number of elements over all stacks
+  int getNumberOfElements() const { return numberOfElements; }
+
+  int getNumberOfElements(int index) const {
+    return getRegion(index).numberOfElements;
+  }
+
+  // Number of slots currently reserved for the stack `index`
+  int getRegionCapacity(int index) const {
+    const Region &region = getRegion(index);
+    return region.limit - region.base;
+  }
+
+  int getNumberOfRepacks() const { return numberOfRepacks; }
+};
+
+#endif  // STACK_ARENA_H
@@ -0,0 +1,246 @@
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "simple_stack.h"
+
+#ifndef STACK_BLOB_H
+#define STACK_BLOB_H
+
+// A read-only view of one record of a `StackBlob`. It does not own the bytes.
+class BlobView {
+  const char *data_;
+  std::size_t size_;
+
+ public:
+  BlobView() : data_(nullptr), size_(0) {}
+  BlobView(const void *data, std::size_t size)
+      : data_(static_cast<const char *>(data)), size_(size) {}
+  BlobView(const std::string &value) : BlobView(value.data(), value.size()) {}
+  BlobView(const char *value) : BlobView(value, std::strlen(value)) {}
+
+  const char *data() const { return data_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Records start 8-byte aligned, so arrays of int, double, ... can be read in
+  // place.
+  template <class U>
+  const U *dataAs() const {
+    return reinterpret_cast<const U *>(data_);
+  }
+
+  std::string toString() const { return std::string(data_, size_); }
+};
+
+inline bool operator==(const BlobView &a, const BlobView &b) {
+  return a.size() == b.size() &&
+         (a.size() == 0 || std::memcmp(a.data(), b.data(), a.size()) == 0);
+}
+
+inline bool operator!=(const BlobView &a, const BlobView &b) {
+  return !(a == b);
+}
+
+// A stack of variable-length byte records packed back to back in one growable
+// buffer, for strings and other blobs that would otherwise cost one heap
+// allocation per element in `StackArray<std::string>`.
+//
+// Every record is laid out as
+//
+//   [bytes][padding][uint32_t size]
+//
+// and rounded up to a multiple of 8 bytes, so that `pop()` finds the start of
+// the record from the size trailer in front of the end and every record starts
+// 8-byte aligned. Push copies the bytes once; `peek()` and `pop()` hand out
+// views into the buffer, which stay valid until the next push (which may
+// reallocate the buffer), `clear()` or destruction.
+//
+// The capacity is the maximum number of records, like for the other stacks.
+// The buffer itself grows by doubling.
+class StackBlob : public Stack<BlobView> {
+  static constexpr std::size_t kAlignment = 8;
+  static constexpr std::size_t kTrailerSize = sizeof(std::uint32_t);
+
+  std::unique_ptr<char[]> buffer;
+  std::size_t bufferSize = 0;
+  // Number of bytes in use, always a multiple of `kAlignment`.
+  std::size_t numberOfBytes = 0;
+
+  static std::size_t getRecordSize(std::size_t size) {
+    return (size + kTrailerSize + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  std::uint32_t getTopSize() const {
+    std::uint32_t size;
+    std::memcpy(&size, buffer.get() + numberOfBytes - kTrailerSize,
+                kTrailerSize);
+    return size;
+  }
+
+  void reserveBytes(std::size_t required) {
+    if (required <= bufferSize) {
+      return;
+    }
+    std::size_t newSize = bufferSize == 0 ? 256 : bufferSize;
+    while (newSize < required) {
+      newSize *= 2;
+    }
+    std::unique_ptr<char[]> newBuffer(new char[newSize]);
+    if (numberOfBytes > 0) {
+      std::memcpy(newBuffer.get(), buffer.get(), numberOfBytes);
+    }
+    buffer = std::move(newBuffer);
+    bufferSize = newSize;
+  }
+
+ public:
+  StackBlob(int capacity) {
+    if (!isValidCapacity(capacity)) {
+      throw StackInvalidCapacityError(
+          "Capacity must be greater than 0. You gave " +
+          std::to_string(capacity));
+    }
+    this->capacity = capacity;
+  }
+
+  // Copy constructor
+  StackBlob(const StackBlob &other) {
+    this->capacity = other.capacity;
+    this->numberOfElements = other.numberOfElements;
+    reserveBytes(other.numberOfBytes);
+    if (other.numberOfBytes > 0) {
+      std::memcpy(buffer.get(), other.buffer.get(), other.numberOfBytes);
+    }
+    numberOfBytes = other.numberOfBytes;
+  }
+
+  // Copy assignment
+  StackBlob &operator=(const StackBlob &other) {
+    if (this != &other) {
+      clear();
+
+      // Create a temporary copy-object.
+      StackBlob temp = other;
+      std::swap(this->capacity, temp.capacity);
+      std::swap(this->numberOfElements, temp.numberOfElements);
+      std::swap(buffer, temp.buffer);
+      std::swap(bufferSize, temp.bufferSize);
+      std::swap(numberOfBytes, temp.numberOfBytes);
+    }
+    return *this;
+  }
+
+  // Move constructor
+  StackBlob(StackBlob &&other) noexcept {
+    this->capacity = other.capacity;
+    this->numberOfElements = other.numberOfElements;
+    buffer = std::move(other.buffer);
+    bufferSize = other.bufferSize;
+    numberOfBytes = other.numberOfBytes;
+
+    other.capacity = 0;
+    other.numberOfElements = 0;
+    other.bufferSize = 0;
+    other.numberOfBytes = 0;
+  }
+
+  // Move assignment
+  StackBlob &operator=(StackBlob &&other) noexcept {
+    if (this != &other) {
+      clear();
+
+      std::swap(this->capacity, other.capacity);
+      std::swap(this->numberOfElements, other.numberOfElements);
+      std::swap(buffer, other.buffer);
+      std::swap(bufferSize, other.bufferSize);
+      std::swap(numberOfBytes, other.numberOfBytes);
+    }
+    return *this;
+  }
+
+  ~StackBlob() { clear(); }
+
+  void clear() override {
+    buffer = nullptr;
+    bufferSize = 0;
+    numberOfBytes = 0;
+    this->numberOfElements = 0;
+    this->capacity = 0;
+  }
+
+  int getNumberOfElements() const override { return this->numberOfElements; }
+
+  bool isEmpty() const override { return getNumberOfElements() == 0; }
+
+  bool isFull() const override {
+    return getNumberOfElements() == this->capacity;
+  }
+
+  BlobView peek() override {
+    if (isEmpty()) {
+      throw StackUnderflowError("You can't peek an empty stack.");
+    }
+    std::uint32_t size = getTopSize();
+    return BlobView(buffer.get() + numberOfBytes - getRecordSize(size), size);
+  }
+
+  // Return and remove the top record. The view stays valid until the next
+  // push.
+  BlobView pop() override {
+    BlobView value = peek();
+    numberOfBytes -= getRecordSize(value.size());
+    this->numberOfElements--;
+    return value;
+  }
+
+  void push(BlobView value) override { push(value.data(), value.size()); }
+
+  void push(const void *data, std::size_t size) {
+    if (isFull()) {
+      throw StackOverflowError(
+          "Stack Overflow: You can't push to a full stack. The "
+          "numberOfElements of the "
+          "stack is " +
+          std::to_string(this->capacity));
+    }
+    if (size > UINT32_MAX) {
+      throw std::length_error("A record can hold at most " +
+                              std::to_string(UINT32_MAX) + " bytes. You gave " +
+                              std::to_string(size));
+    }
+    std::size_t recordSize = getRecordSize(size);
+    // `data` may point into our own buffer, e.g. a view returned by `pop()`,
+    // and reserveBytes() may move the buffer.
+    const char *source = static_cast<const char *>(data);
+    std::less<const char *> less;
+    bool aliases = size > 0 && !less(source, buffer.get()) &&
+                   less(source, buffer.get() + bufferSize);
+    std::size_t offset = aliases ? source - buffer.get() : 0;
+    reserveBytes(numberOfBytes + recordSize);
+    if (aliases) {
+      source = buffer.get() + offset;
+    }
+
+    char *record = buffer.get() + numberOfBytes;
+    if (size > 0) {
+      std::memmove(record, source, size);
+    }
+    std::uint32_t trailer = static_cast<std::uint32_t>(size);
+    std::memcpy(record + recordSize - kTrailerSize, &trailer, kTrailerSize);
+    numberOfBytes += recordSize;
+    this->numberOfElements++;
+  }
+
+  // Bytes used by the records, including padding and trailers
+  std::size_t getNumberOfBytes() const { return numberOfBytes; }
+
+  // Bytes currently allocated for the buffer
+  std::size_t getBufferSize() const { return bufferSize; }
+};
+
+#endif  // STACK_BLOB_H
@@ -0,0 +1,203 @@
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "simple_stack.h"
+
+#ifndef STACK_FLAT_COMBINING_H
+#define STACK_FLAT_COMBINING_H
+
+// A concurrent stack using flat combining (Hendler, Incze, Shavit, Tzafrir,
+// SPAA 2010).
+//
+// A thread does not touch the storage itself. It claims a publication slot,
+// writes its request there and tries to become the combiner. The combiner
+// holds the lock, scans every slot, first pairs pending pushes with pending
+// pops (elimination: the value is handed over without touching the storage)
+// and then applies the rest to a `StackArray` in one tight loop. Threads that
+// lost the race spin on their own slot until the combiner has served them.
+template <class T>
+class StackFlatCombining : public Stack<T> {
+  enum SlotState : int {
+    FREE,
+    CLAIMED,
+    PUSH_REQUESTED,
+    POP_REQUESTED,
+    DONE,
+    OVERFLOWED,
+    UNDERFLOWED,
+  };
+
+  // Slots are padded apart by a cache line, so that waiting threads do not
+  // invalidate each other's lines while spinning. (Padding rather than
+  // `alignas`, because C++14 `new` ignores over-alignment.)
+  struct Slot {
+    std::atomic<int> state{FREE};
+    T value;
+    char padding[64];
+  };
+
+  // Mutable so that the const queries can take it too.
+  mutable std::mutex mutex;
+  StackArray<T> storage;
+  std::unique_ptr<Slot[]> slots;
+  int numberOfSlots;
+  // Scratch space of the combiner, kept to avoid allocating in every pass.
+  std::vector<Slot *> pushes;
+  std::vector<Slot *> pops;
+
+  // Apply every published request. Must be called with `mutex` held.
+  void combine() {
+    pushes.clear();
+    pops.clear();
+    for (int i = 0; i < numberOfSlots; i++) {
+      int state = slots[i].state.load(std::memory_order_acquire);
+      if (state == PUSH_REQUESTED) {
+        pushes.push_back(&slots[i]);
+      } else if (state == POP_REQUESTED) {
+        pops.push_back(&slots[i]);
+      }
+    }
+
+    // A push immediately followed by a pop leaves the stack unchanged.
+    while (!pushes.empty() && !pops.empty()) {
+      Slot *pusher = pushes.back();
+      Slot *popper = pops.back();
+      pushes.pop_back();
+      pops.pop_back();
+      popper->value = std::move(pusher->value);
+      pusher->state.store(DONE, std::memory_order_release);
+      popper->state.store(DONE, std::memory_order_release);
+    }
+
+    for (Slot *pusher : pushes) {
+      if (storage.isFull()) {
+        pusher->state.store(OVERFLOWED, std::memory_order_release);
+      } else {
+        storage.push(std::move(pusher->value));
+        pusher->state.store(DONE, std::memory_order_release);
+      }
+    }
+    for (Slot *popper : pops) {
+      if (storage.isEmpty()) {
+        popper->state.store(UNDERFLOWED, std::memory_order_release);
+      } else {
+        popper->value = storage.pop();
+        popper->state.store(DONE, std::memory_order_release);
+      }
+    }
+  }
+
+  Slot &claimSlot() {
+    // Start at a per-thread position so that threads rarely collide.
+    int i = static_cast<int>(std::hash<std::thread::id>()(
+                                 std::this_thread::get_id()) %
+                             numberOfSlots);
+    while (true) {
+      int expected = FREE;
+      if (slots[i].state.compare_exchange_weak(expected, CLAIMED,
+                                               std::memory_order_acquire)) {
+        return slots[i];
+      }
+      i = (i + 1) % numberOfSlots;
+      if (i == 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  // Publish the request in `slot`, then combine or wait until it is served.
+  // Return the final state of the slot.
+  int execute(Slot &slot, SlotState request) {
+    slot.state.store(request, std::memory_order_release);
+    while (true) {
+      if (mutex.try_lock()) {
+        combine();
+        mutex.unlock();
+      }
+      int state = slot.state.load(std::memory_order_acquire);
+      if (state != request) {
+        return state;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+ public:
+  StackFlatCombining(int capacity, int numberOfSlots = 16)
+      : storage(capacity) {
+    if (numberOfSlots <= 0) {
+      throw StackInvalidCapacityError(
+          "Number of slots must be greater than 0. You gave " +
+          std::to_string(numberOfSlots));
+    }
+    this->capacity = capacity;
+    this->numberOfSlots = numberOfSlots;
+    slots = std::make_unique<Slot[]>(numberOfSlots);
+    pushes.reserve(numberOfSlots);
+    pops.reserve(numberOfSlots);
+  }
+
+  // Other threads may be publishing into the slots, so the stack stays put.
+  StackFlatCombining(const StackFlatCombining &other) = delete;
+  StackFlatCombining &operator=(const StackFlatCombining &other) = delete;
+
+  void push(T value) override {
+    Slot &slot = claimSlot();
+    slot.value = std::move(value);
+    int state = execute(slot, PUSH_REQUESTED);
+    slot.state.store(FREE, std::memory_order_release);
+    if (state == OVERFLOWED) {
+      throw StackOverflowError(
+          "Stack Overflow: You can't push to a full stack. The "
+          "numberOfElements of the "
+          "stack is " +
+          std::to_string(this->capacity));
+    }
+  }
+
+  // Return and remove the top item
+  T pop() override {
+    Slot &slot = claimSlot();
+    int state = execute(slot, POP_REQUESTED);
+    T value = std::move(slot.value);
+    slot.state.store(FREE, std::memory_order_release);
+    if (state == UNDERFLOWED) {
+      throw StackUnderflowError("You can't pop an empty stack.");
+    }
+    return value;
+  }
+
+  T peek() override {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (storage.isEmpty()) {
+      throw StackUnderflowError("You can't peek an empty stack.");
+    }
+    return storage.peek();
+  }
+
+  bool isEmpty() const override { return getNumberOfElements() == 0; }
+
+  bool isFull() const override {
+    return getNumberOfElements() == this->capacity;
+  }
+
+  int getNumberOfElements() const override {
+    std::lock_guard<std::mutex> lock(mutex);
+    return storage.getNumberOfElements();
+  }
+
+  // Drop every element. The capacity is kept because other threads may still
+  // use the stack.
+  void clear() override {
+    std::lock_guard<std::mutex> lock(mutex);
+    storage.rollback(StackMark{0});
+  }
+};
+
+#endif  // STACK_FLAT_COMBINING_H
@@ -0,0 +1,196 @@
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "simple_stack.h"
+
+#ifndef STACK_INTRUSIVE_H
+#define STACK_INTRUSIVE_H
+
+// A stack that links the caller's own objects instead of copying them into
+// nodes of its own. `T` embeds the link, by default a member `T *next`; any
+// other member can be named through `Next`:
+//
+//   struct Task { Task *next; ... };
+//   StackIntrusive<Task> runQueue(1024);
+//
+//   struct Block { Block *link; ... };
+//   StackIntrusive<Block, &Block::link> freeList(1024);
+//
+// push/pop never allocate or copy. The stack does not own the objects: they
+// must outlive their time on the stack, and an object can be on at most one
+// stack per link member at a time.
+template <class T, T *T::*Next = &T::next>
+class StackIntrusive : public Stack<T *> {
+  T *top = nullptr;
+
+ public:
+  StackIntrusive(int capacity) {
+    if (!isValidCapacity(capacity)) {
+      throw StackInvalidCapacityError(
+          "Capacity must be greater than 0. You gave " +
+          std::to_string(capacity));
+    }
+    this->capacity = capacity;
+  }
+
+  // Copying would link the same objects into two stacks.
+  StackIntrusive(const StackIntrusive &other) = delete;
+  StackIntrusive &operator=(const StackIntrusive &other) = delete;
+
+  // Move constructor
+  StackIntrusive(StackIntrusive &&other) noexcept {
+    this->capacity = other.capacity;
+    this->numberOfElements = other.numberOfElements;
+    top = other.top;
+
+    other.capacity = 0;
+    other.numberOfElements = 0;
+    other.top = nullptr;
+  }
+
+  // Move assignment
+  StackIntrusive &operator=(StackIntrusive &&other) noexcept {
+    if (this != &other) {
+      clear();
+
+      std::swap(this->capacity, other.capacity);
+      std::swap(this->numberOfElements, other.numberOfElements);
+      std::swap(top, other.top);
+    }
+    return *this;
+  }
+
+  ~StackIntrusive() { clear(); }
+
+  // Unlink every object. The objects themselves are left alone.
+  void clear() override {
+    top = nullptr;
+    this->numberOfElements = 0;
+    this->capacity = 0;
+  }
+
+  int getNumberOfElements() const override { return this->numberOfElements; }
+
+  bool isEmpty() const override { return top == nullptr; }
+
+  bool isFull() const override {
+    return getNumberOfElements() == this->capacity;
+  }
+
+  T *peek() override {
+    if (isEmpty()) {
+      throw StackUnderflowError("You can't peek an empty stack.");
+    }
+    return top;
+  }
+
+  // Return and unlink the top object
+  T *pop() override {
+    if (isEmpty()) {
+      throw StackUnderflowError("You can't pop an empty stack.");
+    }
+    T *node = top;
+    top = node->*Next;
+    node->*Next = nullptr;
+    this->numberOfElements--;
+    return node;
+  }
+
+  void push(T *node) override {
+    if (isFull()) {
+      throw StackOverflowError(
+          "You can't push to a full stack. The numberOfElements of the stack "
+          "is " +
+          std::to_string(this->capacity));
+    }
+    node->*Next = top;
+    top = node;
+    this->numberOfElements++;
+  }
+};
+
+// Lock-free variant of `StackIntrusive` (Treiber stack) for free-lists and
+// run-queues shared between threads. The link must be a member
+// `std::atomic<T *>`, by default `next`.
+//
+// Because objects are recycled rather than freed, a popping thread can read
+// the link of an object that was popped and pushed again in the meantime
+// (the ABA problem). The head therefore carries a 16-bit version counter in
+// the upper bits of the pointer word, which assumes the 48-bit user-space
+// addresses of x86-64 and AArch64. Objects must not be freed while another
+// thread may still be popping from the stack.
+//
+// The stack is unbounded and keeps no element count, which would otherwise be
+// a second contended word.
+template <class T, std::atomic<T *> T::*Next = &T::next>
+class StackIntrusiveLockFree {
+  static_assert(sizeof(std::uintptr_t) == 8,
+                "StackIntrusiveLockFree needs 64-bit pointers");
+
+  static constexpr int kPointerBits = 48;
+  static constexpr std::uint64_t kPointerMask =
+      (std::uint64_t(1) << kPointerBits) - 1;
+
+  std::atomic<std::uint64_t> head{0};
+
+  static T *pointerOf(std::uint64_t word) {
+    return reinterpret_cast<T *>(static_cast<std::uintptr_t>(word & kPointerMask));
+  }
+
+  // Pack `node` with the version after `previous`.
+  static std::uint64_t pack(T *node, std::uint64_t previous) {
+    std::uint64_t version = (previous >> kPointerBits) + 1;
+    return (version << kPointerBits) |
+           (reinterpret_cast<std::uintptr_t>(node) & kPointerMask);
+  }
+
+ public:
+  StackIntrusiveLockFree() = default;
+
+  StackIntrusiveLockFree(const StackIntrusiveLockFree &other) = delete;
+  StackIntrusiveLockFree &operator=(const StackIntrusiveLockFree &other) =
+      delete;
+
+  bool isEmpty() const {
+    return pointerOf(head.load(std::memory_order_acquire)) == nullptr;
+  }
+
+  void push(T *node) {
+    std::uint64_t old = head.load(std::memory_order_relaxed);
+    do {
+      (node->*Next).store(pointerOf(old), std::memory_order_relaxed);
+    } while (!head.compare_exchange_weak(old, pack(node, old),
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+  }
+
+  // Return and unlink the top object, or nullptr if the stack is empty.
+  T *tryPop() {
+    std::uint64_t old = head.load(std::memory_order_acquire);
+    while (true) {
+      T *node = pointerOf(old);
+      if (node == nullptr) {
+        return nullptr;
+      }
+      T *next = (node->*Next).load(std::memory_order_relaxed);
+      if (head.compare_exchange_weak(old, pack(next, old),
+                                     std::memory_order_acquire,
+                                     std::memory_order_acquire)) {
+        return node;
+      }
+    }
+  }
+
+  // Return and unlink the top object
+  T *pop() {
+    T *node = tryPop();
+    if (node == nullptr) {
+      throw StackUnderflowError("You can't pop an empty stack.");
+    }
+    return node;
+  }
+};
+
+#endif  // STACK_INTRUSIVE_H
@@ -0,0 +1,300 @@
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "simple_stack.h"
+
+#ifndef STACK_PACKED_H
+#define STACK_PACKED_H
+
+// The narrowest unsigned type that holds a `Bits`-wide element, or bool for
+// single bits.
+template <int Bits>
+using PackedValue = typename std::conditional<
+    Bits == 1, bool,
+    typename std::conditional<
+        Bits <= 8, std::uint8_t,
+        typename std::conditional<Bits <= 16, std::uint16_t,
+                                  std::uint32_t>::type>::type>::type;
+
+// A stack of `Bits`-wide unsigned elements packed into 64-bit words, e.g.
+// `StackPacked<1>` for booleans or `StackPacked<4>` for small tags. It uses
+// `Bits` bits per element where `StackArray<bool>` uses a whole byte.
+//
+// `Bits` must be a power of two up to 32 so that no element straddles two
+// words. Element i lives in word i / (64 / Bits) at bit offset
+// (i % (64 / Bits)) * Bits. Bits above the top element are always zero, which
+// keeps `pushMany()`/`popMany()` and the counting queries word-at-a-time.
+template <int Bits>
+class StackPacked : public Stack<PackedValue<Bits>> {
+  static_assert(Bits == 1 || Bits == 2 || Bits == 4 || Bits == 8 ||
+                    Bits == 16 || Bits == 32,
+                "Bits must be a power of two between 1 and 32");
+
+ public:
+  typedef PackedValue<Bits> Value;
+
+  static constexpr int kElementsPerWord = 64 / Bits;
+
+ private:
+  static constexpr std::uint64_t kElementMask =
+      (std::uint64_t(1) << Bits) - 1;
+
+  std::unique_ptr<std::uint64_t[]> words;
+
+  static int getNumberOfWords(int numberOfElements) {
+    return (numberOfElements + kElementsPerWord - 1) / kElementsPerWord;
+  }
+
+  // Mask of the lowest `count` elements of a word
+  static std::uint64_t getLowMask(int count) {
+    return count >= kElementsPerWord
+               ? ~std::uint64_t(0)
+               : (std::uint64_t(1) << (count * Bits)) - 1;
+  }
+
+  // Bit 0 of every element of a word
+  static std::uint64_t getLowBits() {
+    std::uint64_t lowBits = 0;
+    for (int i = 0; i < kElementsPerWord; i++) {
+      lowBits |= std::uint64_t(1) << (i * Bits);
+    }
+    return lowBits;
+  }
+
+  static int popcount(std::uint64_t word) {
+    return static_cast<int>(std::bitset<64>(word).count());
+  }
+
+  // Drop everything above `numberOfElements`, keeping the bits above the top
+  // zero.
+  void truncate(int numberOfElements) {
+    int first = numberOfElements / kElementsPerWord;
+    int last = getNumberOfWords(this->numberOfElements);
+    if (first < last) {
+      words[first] &= getLowMask(numberOfElements % kElementsPerWord);
+      for (int i = first + 1; i < last; i++) {
+        words[i] = 0;
+      }
+    }
+    this->numberOfElements = numberOfElements;
+  }
+
+ public:
+  StackPacked(int capacity) {
+    if (!isValidCapacity(capacity)) {
+      throw StackInvalidCapacityError(
+          "Capacity must be greater than 0. You gave " +
+          std::to_string(capacity));
+    }
+    this->capacity = capacity;
+    // Value-initialised, i.e. all zero.
+    words = std::make_unique<std::uint64_t[]>(getNumberOfWords(capacity));
+  }
+
+  // Copy constructor
+  StackPacked(const StackPacked &other) {
+    this->capacity = other.capacity;
+    this->numberOfElements = other.numberOfElements;
+    words = std::make_unique<std::uint64_t[]>(getNumberOfWords(this->capacity));
+
+    for (int i = 0; i < getNumberOfWords(this->numberOfElements); i++) {
+      words[i] = other.words[i];
+    }
+  }
+
+  // Copy assignment
+  StackPacked &operator=(const StackPacked &other) {
+    if (this != &other) {
+      clear();
+
+      // Create a temporary copy-object.
+      StackPacked temp = other;
+      std::swap(this->capacity, temp.capacity);
+      std::swap(this->numberOfElements, temp.numberOfElements);
+      std::swap(words, temp.words);
+    }
+    return *this;
+  }
+
+  // Move constructor
+  StackPacked(StackPacked &&other) noexcept {
+    this->numberOfElements = other.numberOfElements;
+    this->capacity = other.capacity;
+    words = std::move(other.words);
+
+    other.numberOfElements = 0;
+    other.capacity = 0;
+  }
+
+  // Move assignment
+  StackPacked &operator=(StackPacked &&other) noexcept {
+    if (this != &other) {
+      clear();
+
+      std::swap(this->capacity, other.capacity);
+      std::swap(this->numberOfElements, other.numberOfElements);
+      std::swap(words, other.words);
+    }
+    return *this;
+  }
+
+  ~StackPacked() { clear(); }
+
+  void clear() override {
+    words = nullptr;
+    this->numberOfElements = 0;
+    this->capacity = 0;
+  }
+
+  int getNumberOfElements() const override { return this->numberOfElements; }
+
+  bool isEmpty() const override { return getNumberOfElements() == 0; }
+
+  bool isFull() const override {
+    return getNumberOfElements() == this->capacity;
+  }
+
+  Value peek() override {
+    if (isEmpty()) {
+      throw StackUnderflowError("You can't peek an empty stack.");
+    }
+    int index = this->numberOfElements - 1;
+    return static_cast<Value>(
+        (words[index / kElementsPerWord] >> (index % kElementsPerWord * Bits)) &
+        kElementMask);
+  }
+
+  // Return and remove the top item
+  Value pop() override {
+    if (isEmpty()) {
+      throw StackUnderflowError("You can't pop an empty stack.");
+    }
+    int index = this->numberOfElements - 1;
+    std::uint64_t &word = words[index / kElementsPerWord];
+    int shift = index % kElementsPerWord * Bits;
+    Value value = static_cast<Value>((word >> shift) & kElementMask);
+    word &= ~(kElementMask << shift);
+    this->numberOfElements--;
+    return value;
+  }
+
+  void push(Value value) override {
+    if (isFull()) {
+      throw StackOverflowError(
+          "Stack Overflow: You can't push to a full stack. The "
+          "numberOfElements of the "
+          "stack is " +
+          std::to_string(this->capacity));
+    }
+    if (static_cast<std::uint64_t>(value) > kElementMask) {
+      throw std::out_of_range("Value " + std::to_string(value) +
+                              " does not fit in " + std::to_string(Bits) +
+                              " bits.");
+    }
+    int index = this->numberOfElements;
+    words[index / kElementsPerWord] |= static_cast<std::uint64_t>(value)
+                                       << (index % kElementsPerWord * Bits);
+    this->numberOfElements++;
+  }
+
+  // Push `count` elements given in the packed layout of this stack: element i
+  // of `packed` is at bit (i % kElementsPerWord) * Bits of packed[i /
+  // kElementsPerWord]. The elements are pushed in that order.
+  void pushMany(const std::uint64_t *packed, int count) {
+    if (count < 0 || this->capacity - this->numberOfElements < count) {
+      throw StackOverflowError(
+          "Stack Overflow: You can't push " + std::to_string(count) +
+          " elements. The numberOfElements of the stack is " +
+          std::to_string(this->capacity));
+    }
+    int first = this->numberOfElements / kElementsPerWord;
+    int shift = this->numberOfElements % kElementsPerWord * Bits;
+    for (int i = 0; i < getNumberOfWords(count); i++) {
+      // Unused bits of the last source word must not leak in.
+      std::uint64_t word =
+          packed[i] & getLowMask(count - i * kElementsPerWord);
+      words[first + i] |= word << shift;
+      if (shift != 0 && first + i + 1 < getNumberOfWords(this->capacity)) {
+        words[first + i + 1] = word >> (64 - shift);
+      }
+    }
+    this->numberOfElements += count;
+  }
+
+  // Pop the top `count` elements into `packed`, in the layout of
+  // `pushMany()`: pushMany(x, n) followed by popMany(y, n) leaves y == x.
+  void popMany(std::uint64_t *packed, int count) {
+    if (count < 0 || this->numberOfElements < count) {
+      throw StackUnderflowError("You can't pop " + std::to_string(count) +
+                                " elements from a stack of " +
+                                std::to_string(this->numberOfElements));
+    }
+    int start = this->numberOfElements - count;
+    int first = start / kElementsPerWord;
+    int shift = start % kElementsPerWord * Bits;
+    int last = getNumberOfWords(this->numberOfElements);
+    for (int i = 0; i < getNumberOfWords(count); i++) {
+      std::uint64_t word = words[first + i] >> shift;
+      if (shift != 0 && first + i + 1 < last) {
+        word |= words[first + i + 1] << (64 - shift);
+      }
+      packed[i] = word & getLowMask(count - i * kElementsPerWord);
+    }
+    truncate(start);
+  }
+
+  void rollback(StackMark mark) override {
+    this->checkMark(mark);
+    truncate(mark.numberOfElements);
+  }
+
+  // Number of set bits over all elements. For `StackPacked<1>` this is the
+  // number of `true` elements.
+  int getPopulationCount() const {
+    int count = 0;
+    for (int i = 0; i < getNumberOfWords(this->numberOfElements); i++) {
+      count += popcount(words[i]);
+    }
+    return count;
+  }
+
+  // Number of elements equal to `value`, a word at a time.
+  int count(Value value) const {
+    std::uint64_t pattern = 0;
+    for (int i = 0; i < kElementsPerWord; i++) {
+      pattern |= (static_cast<std::uint64_t>(value) & kElementMask)
+                 << (i * Bits);
+    }
+    int numberOfWords = getNumberOfWords(this->numberOfElements);
+    int mismatches = 0;
+    for (int i = 0; i < numberOfWords; i++) {
+      // Fold every element onto its lowest bit: it is set iff the element
+      // differs from `value`.
+      std::uint64_t x = words[i] ^ pattern;
+      for (int s = 1; s < Bits; s *= 2) {
+        x |= x >> s;
+      }
+      x &= getLowBits();
+      if (i == numberOfWords - 1) {
+        x &= getLowMask(this->numberOfElements - i * kElementsPerWord);
+      }
+      mismatches += popcount(x);
+    }
+    return this->numberOfElements - mismatches;
+  }
+
+  // Bytes allocated for the elements
+  std::size_t getNumberOfBytes() const {
+    return static_cast<std::size_t>(getNumberOfWords(this->capacity)) *
+           sizeof(std::uint64_t);
+  }
+
+  const std::uint64_t *getWords() const { return words.get(); }
+};
+
+#endif  // STACK_PACKED_H
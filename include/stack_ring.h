@@ -0,0 +1,178 @@
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "simple_stack.h"
+
+#ifndef STACK_RING_H
+#define STACK_RING_H
+
+// A fixed-capacity stack for undo histories and recent-event trails. Pushing
+// onto a full stack does not throw `StackOverflowError`; it evicts the bottom
+// (oldest) element instead.
+//
+// The elements live in a circular buffer, so an eviction only advances the
+// index of the bottom element instead of shifting the whole array. Evictions
+// are counted, and an optional callback sees every evicted element before it
+// is overwritten.
+template <class T>
+class StackRing : public Stack<T> {
+  std::unique_ptr<T[]> array;
+  // Index of the bottom element in `array`
+  int bottom = 0;
+  long long numberOfEvictions = 0;
+  std::function<void(const T &)> onEviction;
+
+  // Position of the i-th element from the bottom
+  int getIndex(int i) const {
+    int index = bottom + i;
+    return index >= this->capacity ? index - this->capacity : index;
+  }
+
+ public:
+  StackRing(int capacity) {
+    if (!isValidCapacity(capacity)) {
+      throw StackInvalidCapacityError(
+          "Capacity must be greater than 0. You gave " +
+          std::to_string(capacity));
+    }
+    this->capacity = capacity;
+    array = std::make_unique<T[]>(capacity);
+  }
+
+  // Copy constructor. The copy starts at the bottom of its own array.
+  StackRing(const StackRing &other) {
+    this->capacity = other.capacity;
+    this->numberOfElements = other.numberOfElements;
+    numberOfEvictions = other.numberOfEvictions;
+    onEviction = other.onEviction;
+    array = std::make_unique<T[]>(this->capacity);
+
+    for (int i = 0; i < this->numberOfElements; i++) {
+      array[i] = other.array[other.getIndex(i)];
+    }
+  }
+
+  // Copy assignment
+  StackRing &operator=(const StackRing &other) {
+    if (this != &other) {
+      clear();
+
+      // Create a temporary copy-object.
+      StackRing temp = other;
+      std::swap(this->capacity, temp.capacity);
+      std::swap(this->numberOfElements, temp.numberOfElements);
+      std::swap(array, temp.array);
+      std::swap(bottom, temp.bottom);
+      std::swap(numberOfEvictions, temp.numberOfEvictions);
+      std::swap(onEviction, temp.onEviction);
+    }
+    return *this;
+  }
+
+  // Move constructor
+  StackRing(StackRing &&other) noexcept {
+    this->numberOfElements = other.numberOfElements;
+    this->capacity = other.capacity;
+    array = std::move(other.array);
+    bottom = other.bottom;
+    numberOfEvictions = other.numberOfEvictions;
+    onEviction = std::move(other.onEviction);
+
+    other.array = nullptr;
+    other.numberOfElements = 0;
+    other.capacity = 0;
+    other.bottom = 0;
+    other.numberOfEvictions = 0;
+  }
+
+  // Move assignment
+  StackRing &operator=(StackRing &&other) noexcept {
+    if (this != &other) {
+      clear();
+
+      std::swap(this->capacity, other.capacity);
+      std::swap(this->numberOfElements, other.numberOfElements);
+      std::swap(array, other.array);
+      std::swap(bottom, other.bottom);
+      std::swap(numberOfEvictions, other.numberOfEvictions);
+      std::swap(onEviction, other.onEviction);
+    }
+    return *this;
+  }
+
+  ~StackRing() { clear(); }
+
+  void clear() override {
+    array = nullptr;
+    bottom = 0;
+    this->numberOfElements = 0;
+    this->capacity = 0;
+  }
+
+  bool isEmpty() const override { return this->getNumberOfElements() == 0; }
+
+  bool isFull() const override {
+    return this->getNumberOfElements() == this->capacity;
+  }
+
+  int getNumberOfElements() const override { return this->numberOfElements; }
+
+  T peek() override {
+    if (isEmpty()) {
+      throw StackUnderflowError("You can't peek an empty stack.");
+    }
+    return array[getIndex(this->numberOfElements - 1)];
+  }
+
+  // Return and remove the top item
+  T pop() override {
+    if (isEmpty()) {
+      throw StackUnderflowError("You can't pop an empty stack.");
+    }
+    T value = array[getIndex(this->numberOfElements - 1)];
+    this->numberOfElements--;
+    return value;
+  }
+
+  // Push onto the top. On a full stack the bottom element is evicted first.
+  void push(T value) override {
+    if (this->capacity == 0) {
+      throw StackOverflowError(
+          "Stack Overflow: You can't push to a stack without capacity.");
+    }
+    if (isFull()) {
+      if (onEviction) {
+        onEviction(array[bottom]);
+      }
+      bottom = getIndex(1);
+      this->numberOfElements--;
+      numberOfEvictions++;
+    }
+    array[getIndex(this->numberOfElements)] = std::move(value);
+    this->numberOfElements++;
+  }
+
+  // Call `callback` with every element evicted from now on.
+  void setEvictionCallback(std::function<void(const T &)> callback) {
+    onEviction = std::move(callback);
+  }
+
+  long long getNumberOfEvictions() const { return numberOfEvictions; }
+
+  // The i-th element from the bottom, for walking the history without
+  // popping it.
+  const T &at(int i) const {
+    if (i < 0 || i >= this->numberOfElements) {
+      throw std::out_of_range("Index " + std::to_string(i) +
+                              " is out of range. The stack holds " +
+                              std::to_string(this->numberOfElements) +
+                              " elements.");
+    }
+    return array[getIndex(i)];
+  }
+};
+
+#endif  // STACK_RING_H
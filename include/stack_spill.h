@@ -0,0 +1,497 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/types.h>
+#endif
+
+#include "simple_stack.h"
+
+#ifndef STACK_SPILL_H
+#define STACK_SPILL_H
+
+// How `StackSpill` turns a block of elements into bytes for the spill file and
+// back. The default copies the bytes of trivially copyable types. A custom
+// codec provides the same two static functions, e.g. to compress blocks or to
+// spill types that own heap memory; the encoded size may differ per block.
+template <class T>
+struct SpillCodec {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SpillCodec copies bytes. Give StackSpill a custom codec for "
+                "types that are not trivially copyable.");
+
+  // Replace `bytes` by the encoding of values[0..count).
+  static void encode(const T *values, int count, std::string &bytes) {
+    bytes.assign(reinterpret_cast<const char *>(values), sizeof(T) * count);
+  }
+
+  // Fill values[0..count) from the output of `encode()`.
+  static void decode(const std::string &bytes, T *values, int count) {
+    std::memcpy(values, bytes.data(), sizeof(T) * count);
+  }
+};
+
+// A stack that holds more than fits in memory, for workloads that only touch
+// the top of a very deep stack (e.g. depth-first search).
+//
+// The elements are grouped into blocks of `blockSize`. Only the top
+// `numberOfResidentBlocks` blocks are kept in memory; pushing past them hands
+// the bottom resident block to a background I/O thread, which writes it to a
+// spill file. When pops bring the resident blocks down to
+// `numberOfResidentBlocks - 2`, the block below is read back ahead of time, so
+// that pops usually find it already in memory. The gap of one block between
+// the two thresholds means at most one block is written or read per
+// `blockSize` operations, so push and pop stay amortised O(1) even when the
+// depth oscillates around a block boundary.
+//
+// The spill file is itself used as a stack of encoded blocks: block i starts
+// where block i - 1 ends, and only blocks below the resident ones are valid.
+// It is a temporary file unless `spillPath` is given, in which case that file
+// is created and removed again on destruction.
+//
+// Memory stays bounded at roughly `numberOfResidentBlocks + 7` blocks: the
+// resident ones, at most two being written, one being read, the last emptied
+// top block, two more spare buffers and the encoding of the block in flight.
+// The stack itself is not thread-safe; only its I/O runs concurrently. Errors
+// of the I/O thread are rethrown by the next push or pop that has to wait for
+// it or finds its prefetch done.
+template <class T, class Codec = SpillCodec<T>>
+class StackSpill : public Stack<T> {
+  typedef std::unique_ptr<T[]> Block;
+  // `long` would limit the spill file to 2 GiB where it has 32 bits. 32-bit
+  // Linux builds also need `_FILE_OFFSET_BITS=64` for a 64-bit `off_t`.
+#if defined(_WIN32)
+  typedef long long Offset;
+#elif defined(__unix__) || defined(__APPLE__)
+  typedef off_t Offset;
+#else
+  typedef long Offset;
+#endif
+
+  struct Job {
+    bool isWrite;
+    int index;
+    Block values;
+  };
+
+  static constexpr int kMaxPendingWrites = 2;
+  static constexpr int kMaxSpareBlocks = 2;
+
+  int blockSize;
+  int numberOfResidentBlocks;
+
+  // Blocks [firstResident, firstResident + resident.size()) are in memory, the
+  // last one being the top block. The blocks below are in the spill file or
+  // on their way there.
+  std::deque<Block> resident;
+  int firstResident = 0;
+  // A read of some block has been queued and its result not taken yet. There
+  // is at most one at a time.
+  bool prefetchPending = false;
+  // The last emptied top block, kept so that pushing and popping around a
+  // block boundary does not allocate.
+  Block spare;
+
+  long long numberOfBlockWrites = 0;
+  long long numberOfBlockReads = 0;
+  long long numberOfStalls = 0;
+
+  // Shared with the I/O thread
+  std::mutex mutex;
+  std::condition_variable jobAvailable;
+  std::condition_variable jobDone;
+  std::deque<Job> jobs;
+  std::vector<Block> spareBlocks;
+  int numberOfPendingWrites = 0;
+  bool ioBusy = false;
+  bool stopping = false;
+  std::exception_ptr error;
+  Block prefetched;
+  int prefetchedIndex = -1;
+  // Set with `prefetched`, so that pops can poll it without the mutex.
+  std::atomic<bool> prefetchReady{false};
+
+  // Only used by the I/O thread once it runs
+  std::FILE *file = nullptr;
+  std::string spillPath;
+  // Block i is stored in [blockOffsets[i], blockOffsets[i + 1]).
+  std::vector<Offset> blockOffsets{0};
+  std::string bytes;
+  std::thread ioThread;
+
+  Block allocateBlock() { return Block(new T[blockSize]); }
+
+  // The caller holds `mutex`.
+  Block takeSpareBlockLocked() {
+    if (spareBlocks.empty()) {
+      return nullptr;
+    }
+    Block block = std::move(spareBlocks.back());
+    spareBlocks.pop_back();
+    return block;
+  }
+
+  // The caller holds `mutex`.
+  void recycleBlockLocked(Block block) {
+    if (block != nullptr &&
+        static_cast<int>(spareBlocks.size()) < kMaxSpareBlocks) {
+      spareBlocks.push_back(std::move(block));
+    }
+  }
+
+  static bool seek(std::FILE *file, Offset offset) {
+#if defined(_WIN32)
+    return _fseeki64(file, offset, SEEK_SET) == 0;
+#elif defined(__unix__) || defined(__APPLE__)
+    return fseeko(file, offset, SEEK_SET) == 0;
+#else
+    return std::fseek(file, offset, SEEK_SET) == 0;
+#endif
+  }
+
+  void rethrowError() {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  void writeBlock(int index, const T *values) {
+    Codec::encode(values, blockSize, bytes);
+    Offset offset = blockOffsets[index];
+    if (!seek(file, offset) ||
+        std::fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+      throw std::runtime_error("Could not write block " +
+                               std::to_string(index) + " to the spill file.");
+    }
+    blockOffsets.resize(index + 2);
+    blockOffsets[index + 1] = offset + static_cast<Offset>(bytes.size());
+  }
+
+  void readBlock(int index, T *values) {
+    Offset offset = blockOffsets[index];
+    bytes.resize(blockOffsets[index + 1] - offset);
+    if (!seek(file, offset) ||
+        std::fread(&bytes[0], 1, bytes.size(), file) != bytes.size()) {
+      throw std::runtime_error("Could not read block " +
+                               std::to_string(index) + " from the spill file.");
+    }
+    Codec::decode(bytes, values, blockSize);
+  }
+
+  void runIo() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+      if (stopping) {
+        return;
+      }
+      Job job = std::move(jobs.front());
+      jobs.pop_front();
+      if (error) {
+        // A job failed before, so the offsets this one relies on may be
+        // missing. Drop it; the error is rethrown to the stack anyway.
+        if (job.isWrite) {
+          numberOfPendingWrites--;
+          recycleBlockLocked(std::move(job.values));
+        }
+        jobDone.notify_all();
+        continue;
+      }
+      if (!job.isWrite) {
+        job.values = takeSpareBlockLocked();
+      }
+      ioBusy = true;
+      lock.unlock();
+
+      std::exception_ptr failure;
+      try {
+        if (job.isWrite) {
+          writeBlock(job.index, job.values.get());
+        } else {
+          if (job.values == nullptr) {
+            job.values = allocateBlock();
+          }
+          readBlock(job.index, job.values.get());
+        }
+      } catch (...) {
+        failure = std::current_exception();
+      }
+
+      lock.lock();
+      ioBusy = false;
+      if (failure && !error) {
+        error = failure;
+      }
+      if (job.isWrite) {
+        numberOfPendingWrites--;
+        recycleBlockLocked(std::move(job.values));
+      } else {
+        prefetched = std::move(job.values);
+        prefetchedIndex = job.index;
+        prefetchReady.store(true, std::memory_order_release);
+      }
+      jobDone.notify_all();
+    }
+  }
+
+  void requestBlock(int index) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      rethrowError();
+      jobs.push_back(Job{false, index, nullptr});
+    }
+    jobAvailable.notify_one();
+    prefetchPending = true;
+    numberOfBlockReads++;
+  }
+
+  // Move the result of the pending read in front of the resident blocks, or
+  // drop it if pushes have spilled more blocks since it was requested.
+  void takePrefetched() {
+    std::lock_guard<std::mutex> lock(mutex);
+    rethrowError();
+    prefetchReady.store(false, std::memory_order_relaxed);
+    prefetchPending = false;
+    if (prefetchedIndex == firstResident - 1 &&
+        static_cast<int>(resident.size()) < numberOfResidentBlocks) {
+      resident.push_front(std::move(prefetched));
+      firstResident--;
+    } else {
+      recycleBlockLocked(std::move(prefetched));
+    }
+  }
+
+  void waitForPrefetch() {
+    std::unique_lock<std::mutex> lock(mutex);
+    jobDone.wait(lock, [this] {
+      return prefetchReady.load(std::memory_order_relaxed) || error;
+    });
+    rethrowError();
+  }
+
+  // Make the top block resident when pops have used up every resident block
+  // before the prefetch arrived.
+  void loadTopBlock() {
+    numberOfStalls++;
+    while (resident.empty()) {
+      if (!prefetchPending) {
+        requestBlock(firstResident - 1);
+      }
+      waitForPrefetch();
+      takePrefetched();
+    }
+  }
+
+  // Hand the bottom resident block to the I/O thread.
+  void spillBottomBlock() {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      jobDone.wait(lock, [this] {
+        return numberOfPendingWrites < kMaxPendingWrites || error;
+      });
+      rethrowError();
+      numberOfPendingWrites++;
+      jobs.push_back(Job{true, firstResident, std::move(resident.front())});
+    }
+    jobAvailable.notify_one();
+    resident.pop_front();
+    firstResident++;
+    numberOfBlockWrites++;
+  }
+
+  void addTopBlock() {
+    if (static_cast<int>(resident.size()) == numberOfResidentBlocks) {
+      spillBottomBlock();
+    }
+    Block block = std::move(spare);
+    if (block == nullptr) {
+      std::lock_guard<std::mutex> lock(mutex);
+      block = takeSpareBlockLocked();
+    }
+    resident.push_back(block != nullptr ? std::move(block) : allocateBlock());
+  }
+
+  void releaseTopBlock() {
+    Block block = std::move(resident.back());
+    resident.pop_back();
+    if (spare == nullptr) {
+      spare = std::move(block);
+    } else {
+      std::lock_guard<std::mutex> lock(mutex);
+      recycleBlockLocked(std::move(block));
+    }
+  }
+
+  // Wait until the I/O thread has nothing queued or in progress.
+  void waitForIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    jobDone.wait(lock, [this] {
+      return (jobs.empty() && !ioBusy) || error;
+    });
+  }
+
+ public:
+  StackSpill(int capacity, int blockSize = 4096, int numberOfResidentBlocks = 8,
+             const std::string &spillPath = "") {
+    if (!isValidCapacity(capacity)) {
+      throw StackInvalidCapacityError(
+          "Capacity must be greater than 0. You gave " +
+          std::to_string(capacity));
+    }
+    if (blockSize <= 0) {
+      throw StackInvalidCapacityError(
+          "Block size must be greater than 0. You gave " +
+          std::to_string(blockSize));
+    }
+    if (numberOfResidentBlocks < 3) {
+      throw StackInvalidCapacityError(
+          "Number of resident blocks must be at least 3. You gave " +
+          std::to_string(numberOfResidentBlocks));
+    }
+    this->capacity = capacity;
+    this->blockSize = blockSize;
+    this->numberOfResidentBlocks = numberOfResidentBlocks;
+    this->spillPath = spillPath;
+
+    file = spillPath.empty() ? std::tmpfile()
+                             : std::fopen(spillPath.c_str(), "w+b");
+    if (file == nullptr) {
+      throw std::runtime_error("Could not open the spill file " +
+                               (spillPath.empty() ? "(temporary)" : spillPath));
+    }
+    ioThread = std::thread([this] { runIo(); });
+  }
+
+  // The I/O thread works on this object, so it stays put.
+  StackSpill(const StackSpill &other) = delete;
+  StackSpill &operator=(const StackSpill &other) = delete;
+
+  ~StackSpill() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      // Nothing queued is needed any more.
+      jobs.clear();
+      stopping = true;
+    }
+    jobAvailable.notify_one();
+    ioThread.join();
+    std::fclose(file);
+    if (!spillPath.empty()) {
+      std::remove(spillPath.c_str());
+    }
+  }
+
+  // Remove every element and give back the memory of the blocks. The
+  // capacity is kept, as the stack cannot be moved anyway.
+  void clear() override {
+    waitForIdle();
+    std::lock_guard<std::mutex> lock(mutex);
+    rethrowError();
+    resident.clear();
+    spare = nullptr;
+    spareBlocks.clear();
+    prefetched = nullptr;
+    prefetchReady.store(false, std::memory_order_relaxed);
+    prefetchPending = false;
+    firstResident = 0;
+    this->numberOfElements = 0;
+  }
+
+  int getNumberOfElements() const override { return this->numberOfElements; }
+
+  bool isEmpty() const override { return getNumberOfElements() == 0; }
+
+  bool isFull() const override {
+    return getNumberOfElements() == this->capacity;
+  }
+
+  T peek() override {
+    if (isEmpty()) {
+      throw StackUnderflowError("You can't peek an empty stack.");
+    }
+    if (resident.empty()) {
+      loadTopBlock();
+    }
+    return resident.back()[(this->numberOfElements - 1) % blockSize];
+  }
+
+  // Return and remove the top item
+  T pop() override {
+    if (isEmpty()) {
+      throw StackUnderflowError("You can't pop an empty stack.");
+    }
+    if (resident.empty()) {
+      loadTopBlock();
+    }
+    int offset = (this->numberOfElements - 1) % blockSize;
+
+    // Deal with the prefetch before the element is removed, so that an I/O
+    // error rethrown here leaves the stack as it was.
+    if (prefetchPending) {
+      if (prefetchReady.load(std::memory_order_acquire)) {
+        takePrefetched();
+      }
+    } else {
+      int numberOfResidentBlocksLeft =
+          static_cast<int>(resident.size()) - (offset == 0 ? 1 : 0);
+      if (firstResident > 0 &&
+          numberOfResidentBlocksLeft <= numberOfResidentBlocks - 2) {
+        requestBlock(firstResident - 1);
+      }
+    }
+
+    T value = std::move(resident.back()[offset]);
+    this->numberOfElements--;
+    if (offset == 0) {
+      releaseTopBlock();
+    }
+    return value;
+  }
+
+  void push(T value) override {
+    if (isFull()) {
+      throw StackOverflowError(
+          "Stack Overflow: You can't push to a full stack. The "
+          "numberOfElements of the "
+          "stack is " +
+          std::to_string(this->capacity));
+    }
+    int offset = this->numberOfElements % blockSize;
+    if (offset == 0) {
+      addTopBlock();
+    }
+    resident.back()[offset] = std::move(value);
+    this->numberOfElements++;
+  }
+
+  int getBlockSize() const { return blockSize; }
+
+  // Number of blocks currently in memory, at most `numberOfResidentBlocks`
+  int getNumberOfResidentBlocks() const {
+    return static_cast<int>(resident.size());
+  }
+
+  // Number of blocks handed to the I/O thread for writing
+  long long getNumberOfBlockWrites() const { return numberOfBlockWrites; }
+
+  // Number of blocks requested back from the spill file
+  long long getNumberOfBlockReads() const { return numberOfBlockReads; }
+
+  // Number of times a pop or peek had to wait because the prefetch did not
+  // arrive in time
+  long long getNumberOfStalls() const { return numberOfStalls; }
+};
+
+#endif  // STACK_SPILL_H
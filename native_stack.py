@@ -0,0 +1,319 @@
+"""Native drop-in replacement for `stack.py`.
+
+`StackList` and `StackLinkedList` have the same API and raise the same
+exception classes as in `stack.py`, but the elements live in the C++
+`StackArray`/`StackLinkedList` of the `simple_stack` shared library, reached
+through its C ABI (`include/simple_stack_c.h`) with ctypes.
+
+Elements are int64 (the default), double or bytes. `push_many`/`pop_many`
+cross the Python/C boundary once per batch instead of once per element.
+
+The library is loaded from $SIMPLE_STACK_LIBRARY if set, otherwise from
+`build/src` as produced by `run.sh`.
+"""
+
+import array
+import ctypes
+import os
+from typing import Iterable, List, Tuple
+
+from stack import (
+    Stack,
+    StackError,
+    StackInvalidSizeError,
+    StackEmptyError,
+    StackFullError,
+)
+
+INT64 = "int64"
+DOUBLE = "double"
+BYTES = "bytes"
+
+# Must match `simple_stack_status` and `simple_stack_kind`.
+_OK = 0
+_INVALID_CAPACITY = 1
+_UNDERFLOW = 2
+_OVERFLOW = 3
+_OUT_OF_MEMORY = 4
+_BUFFER_TOO_SMALL = 5
+_INVALID_ARGUMENT = 6
+
+_ARRAY = 0
+_LINKED_LIST = 1
+
+_INT_MAX = 2**31 - 1
+
+
+def _load_library() -> ctypes.CDLL:
+    path = os.environ.get("SIMPLE_STACK_LIBRARY")
+    if path is None:
+        here = os.path.dirname(os.path.abspath(__file__))
+        path = os.path.join(here, "build", "src", "libsimple_stack.so")
+    return ctypes.CDLL(path)
+
+
+_lib = _load_library()
+
+
+def _declare(name: str, restype, *argtypes) -> None:
+    function = getattr(_lib, name)
+    function.restype = restype
+    function.argtypes = argtypes
+
+
+_handle_p = ctypes.POINTER(ctypes.c_void_p)
+_size_p = ctypes.POINTER(ctypes.c_size_t)
+_c_int = ctypes.c_int
+
+for _type in (INT64, DOUBLE, BYTES):
+    _prefix = f"simple_stack_{_type}_"
+    _declare(_prefix + "create", _c_int, _c_int, _c_int, _handle_p)
+    _declare(_prefix + "copy", _c_int, ctypes.c_void_p, _handle_p)
+    _declare(_prefix + "destroy", None, ctypes.c_void_p)
+    _declare(_prefix + "capacity", _c_int, ctypes.c_void_p)
+    _declare(_prefix + "size", _c_int, ctypes.c_void_p)
+
+for _type, _ctype in ((INT64, ctypes.c_int64), (DOUBLE, ctypes.c_double)):
+    _prefix = f"simple_stack_{_type}_"
+    _declare(_prefix + "push", _c_int, ctypes.c_void_p, _ctype)
+    _declare(_prefix + "pop", _c_int, ctypes.c_void_p, ctypes.POINTER(_ctype))
+    _declare(_prefix + "push_many", _c_int, ctypes.c_void_p, ctypes.c_void_p, _c_int)
+    _declare(_prefix + "pop_many", _c_int, ctypes.c_void_p, ctypes.c_void_p, _c_int)
+
+_declare("simple_stack_bytes_push", _c_int, ctypes.c_void_p, ctypes.c_char_p, ctypes.c_size_t)
+_declare(
+    "simple_stack_bytes_pop", _c_int, ctypes.c_void_p, ctypes.c_char_p, ctypes.c_size_t, _size_p
+)
+_declare(
+    "simple_stack_bytes_push_many",
+    _c_int,
+    ctypes.c_void_p,
+    ctypes.POINTER(ctypes.c_char_p),
+    _size_p,
+    _c_int,
+)
+_declare(
+    "simple_stack_bytes_pop_many",
+    _c_int,
+    ctypes.c_void_p,
+    ctypes.c_char_p,
+    ctypes.c_size_t,
+    _size_p,
+    _c_int,
+    _size_p,
+)
+
+# Bound functions per element type, looked up once instead of on every call.
+_FUNCTIONS = {
+    _type: {
+        name[len(f"simple_stack_{_type}_") :]: getattr(_lib, name)
+        for name in (
+            f"simple_stack_{_type}_{suffix}"
+            for suffix in (
+                "create",
+                "copy",
+                "destroy",
+                "capacity",
+                "size",
+                "push",
+                "pop",
+                "push_many",
+                "pop_many",
+            )
+        )
+    }
+    for _type in (INT64, DOUBLE, BYTES)
+}
+
+
+class _NativeStack(Stack):
+    _kind: int
+
+    def __init__(self, size: int, element_type: str = INT64):
+        super().__init__(size)
+        if size > _INT_MAX:
+            raise StackInvalidSizeError(
+                f"Invalid stack size argument: {size}. Should be at most {_INT_MAX}."
+            )
+        if element_type not in (INT64, DOUBLE, BYTES):
+            raise ValueError(f"Unsupported element type: {element_type}")
+        self._element_type = element_type
+        self._functions = _FUNCTIONS[element_type]
+        handle = ctypes.c_void_p()
+        self._check(self._call("create", self._kind, size, ctypes.byref(handle)))
+        self._handle = handle
+
+    def _call(self, name: str, *args):
+        return self._functions[name](*args)
+
+    def _check(self, status: int) -> None:
+        if status == _OK:
+            return
+        if status == _INVALID_CAPACITY:
+            raise StackInvalidSizeError(
+                f"Invalid stack size argument: {self._allocated_size}. "
+                "Should be an integer and larger than 0."
+            )
+        if status == _UNDERFLOW:
+            raise StackEmptyError("You can't pop an empty stack.")
+        if status == _OVERFLOW:
+            raise StackFullError(
+                f"You can't push to a full stack. The size of the stack is {self._allocated_size}"
+            )
+        if status == _OUT_OF_MEMORY:
+            raise MemoryError()
+        raise StackError(f"simple_stack failed with status {status}")
+
+    @classmethod
+    def copy_constructor(cls, other: "_NativeStack"):
+        new_stack = cls.__new__(cls)
+        Stack.__init__(new_stack, other.allocated_size)
+        new_stack._element_type = other._element_type
+        new_stack._functions = other._functions
+        handle = ctypes.c_void_p()
+        if other._handle is None:
+            new_stack._check(
+                new_stack._call("create", cls._kind, other.allocated_size, ctypes.byref(handle))
+            )
+        else:
+            new_stack._check(new_stack._call("copy", other._handle, ctypes.byref(handle)))
+        new_stack._handle = handle
+        return new_stack
+
+    @classmethod
+    def move_constructor(cls, other: "_NativeStack"):
+        new_stack = cls.__new__(cls)
+        Stack.__init__(new_stack, other.allocated_size)
+        new_stack._element_type = other._element_type
+        new_stack._functions = other._functions
+        new_stack._handle = other._handle
+
+        # Like a moved-from C++ stack, the source is left empty.
+        other._handle = None
+        return new_stack
+
+    def __len__(self) -> int:
+        if self._handle is None:
+            return 0
+        return self._call("size", self._handle)
+
+    def __eq__(self, other: "_NativeStack") -> bool:
+        return self.as_tuple == other.as_tuple
+
+    def __del__(self) -> None:
+        if getattr(self, "_handle", None) is not None:
+            self._call("destroy", self._handle)
+            self._handle = None
+
+    @property
+    def as_tuple(self) -> Tuple:
+        """All elements from the bottom to the top."""
+        if self._handle is None:
+            return ()
+        copy = type(self).copy_constructor(self)
+        return tuple(reversed(copy.pop_many(len(copy))))
+
+    def push(self, x) -> None:
+        if self._handle is None:
+            raise StackFullError("You can't push to a moved-from stack.")
+        if self._element_type == BYTES:
+            self._check(self._call("push", self._handle, x, len(x)))
+        else:
+            status = self._functions["push"](self._handle, x)
+            if status != _OK:
+                self._check(status)
+
+    def pop(self) -> object:
+        if self._handle is None:
+            raise StackEmptyError("You can't pop an empty stack.")
+        if self._element_type == BYTES:
+            return self._pop_bytes()
+        value = ctypes.c_int64() if self._element_type == INT64 else ctypes.c_double()
+        status = self._functions["pop"](self._handle, ctypes.byref(value))
+        if status != _OK:
+            self._check(status)
+        return value.value
+
+    def _pop_bytes(self) -> bytes:
+        size = ctypes.c_size_t()
+        buffer = ctypes.create_string_buffer(256)
+        status = self._call("pop", self._handle, buffer, len(buffer), ctypes.byref(size))
+        if status == _BUFFER_TOO_SMALL:
+            buffer = ctypes.create_string_buffer(size.value)
+            status = self._call("pop", self._handle, buffer, len(buffer), ctypes.byref(size))
+        self._check(status)
+        return buffer.raw[: size.value]
+
+    def push_many(self, values: Iterable) -> None:
+        """Push every value in order, or none if they do not all fit."""
+        if self._handle is None:
+            raise StackFullError("You can't push to a moved-from stack.")
+        if self._element_type == BYTES:
+            values = list(values)
+            count = len(values)
+            data = (ctypes.c_char_p * count)(*values)
+            sizes = (ctypes.c_size_t * count)(*map(len, values))
+            self._check(self._call("push_many", self._handle, data, sizes, count))
+            return
+        buffer = array.array("q" if self._element_type == INT64 else "d", values)
+        address, count = buffer.buffer_info()
+        self._check(self._call("push_many", self._handle, address, count))
+
+    def pop_many(self, count: int) -> List:
+        """Pop `count` values, top first, or none if there are fewer."""
+        if count == 0:
+            return []
+        if self._handle is None:
+            raise StackEmptyError("You can't pop an empty stack.")
+        if self._element_type == BYTES:
+            return self._pop_many_bytes(count)
+        buffer = array.array("q" if self._element_type == INT64 else "d", bytes(8 * count))
+        address, _ = buffer.buffer_info()
+        self._check(self._call("pop_many", self._handle, address, count))
+        return buffer.tolist()
+
+    def _pop_many_bytes(self, count: int) -> List[bytes]:
+        sizes = (ctypes.c_size_t * count)()
+        total = ctypes.c_size_t()
+        buffer = ctypes.create_string_buffer(64 * count)
+        status = self._call(
+            "pop_many", self._handle, buffer, len(buffer), sizes, count, ctypes.byref(total)
+        )
+        if status == _BUFFER_TOO_SMALL:
+            buffer = ctypes.create_string_buffer(total.value)
+            status = self._call(
+                "pop_many", self._handle, buffer, len(buffer), sizes, count, ctypes.byref(total)
+            )
+        self._check(status)
+        raw = buffer.raw
+        result = []
+        offset = 0
+        for size in sizes:
+            result.append(raw[offset : offset + size])
+            offset += size
+        return result
+
+
+class StackList(_NativeStack):
+    """Backed by the C++ `StackArray`."""
+
+    _kind = _ARRAY
+
+    def __str__(self) -> str:
+        return f"Stack size: {self.allocated_size}. {list(self.as_tuple)}"
+
+    @property
+    def _stack(self):
+        # Snapshot of the elements, mirroring `stack.StackList._stack`.
+        if self._handle is None:
+            return None
+        return list(self.as_tuple)
+
+
+class StackLinkedList(_NativeStack):
+    """Backed by the C++ `StackLinkedList`."""
+
+    _kind = _LINKED_LIST
+
+    def __str__(self) -> str:
+        return f"Stack size: {self.allocated_size}. {self.as_tuple}"
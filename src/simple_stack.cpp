@@ -1 +1,334 @@
 #include "simple_stack.h"
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "simple_stack_c.h"
+
+////////////////////////////////////////////////////
+// C ABI. The extern "C" functions below are thin wrappers around the
+// templates in this section, which translate exceptions into status codes.
+namespace {
+
+template <class T>
+struct StackHandle {
+  int kind;
+  std::unique_ptr<Stack<T>> stack;
+};
+
+template <class Function>
+int translateExceptions(Function function) {
+  try {
+    function();
+    return SIMPLE_STACK_OK;
+  } catch (const StackInvalidCapacityError &) {
+    return SIMPLE_STACK_INVALID_CAPACITY;
+  } catch (const StackUnderflowError &) {
+    return SIMPLE_STACK_UNDERFLOW;
+  } catch (const StackOverflowError &) {
+    return SIMPLE_STACK_OVERFLOW;
+  } catch (const std::bad_alloc &) {
+    return SIMPLE_STACK_OUT_OF_MEMORY;
+  } catch (...) {
+    return SIMPLE_STACK_ERROR;
+  }
+}
+
+template <class T, class Handle>
+int createStack(int kind, int capacity, Handle **handle) {
+  if (handle == nullptr) {
+    return SIMPLE_STACK_INVALID_ARGUMENT;
+  }
+  if (kind != SIMPLE_STACK_ARRAY && kind != SIMPLE_STACK_LINKED_LIST) {
+    return SIMPLE_STACK_INVALID_ARGUMENT;
+  }
+  return translateExceptions([&] {
+    std::unique_ptr<Handle> created = std::make_unique<Handle>();
+    created->kind = kind;
+    if (kind == SIMPLE_STACK_ARRAY) {
+      created->stack = std::make_unique<StackArray<T>>(capacity);
+    } else {
+      created->stack = std::make_unique<StackLinkedList<T>>(capacity);
+    }
+    *handle = created.release();
+  });
+}
+
+template <class T, class Handle>
+int copyStack(const Handle *other, Handle **handle) {
+  if (other == nullptr || handle == nullptr) {
+    return SIMPLE_STACK_INVALID_ARGUMENT;
+  }
+  return translateExceptions([&] {
+    std::unique_ptr<Handle> created = std::make_unique<Handle>();
+    created->kind = other->kind;
+    if (other->kind == SIMPLE_STACK_ARRAY) {
+      created->stack = std::make_unique<StackArray<T>>(
+          static_cast<const StackArray<T> &>(*other->stack));
+    } else {
+      created->stack = std::make_unique<StackLinkedList<T>>(
+          static_cast<const StackLinkedList<T> &>(*other->stack));
+    }
+    *handle = created.release();
+  });
+}
+
+template <class T>
+void checkRoomFor(const Stack<T> &stack, int count) {
+  if (stack.getCapacity() - stack.getNumberOfElements() < count) {
+    throw StackOverflowError(
+        "You can't push " + std::to_string(count) +
+        " elements. The capacity of the stack is " +
+        std::to_string(stack.getCapacity()));
+  }
+}
+
+template <class T>
+void checkElementsFor(const Stack<T> &stack, int count) {
+  if (stack.getNumberOfElements() < count) {
+    throw StackUnderflowError("You can't pop " + std::to_string(count) +
+                              " elements. The stack holds " +
+                              std::to_string(stack.getNumberOfElements()));
+  }
+}
+
+template <class T, class Handle>
+int pushMany(Handle *handle, const T *values, int count) {
+  if (count < 0 || (values == nullptr && count > 0)) {
+    return SIMPLE_STACK_INVALID_ARGUMENT;
+  }
+  return translateExceptions([&] {
+    checkRoomFor(*handle->stack, count);
+    for (int i = 0; i < count; i++) {
+      handle->stack->push(values[i]);
+    }
+  });
+}
+
+template <class T, class Handle>
+int popMany(Handle *handle, T *values, int count) {
+  if (count < 0 || (values == nullptr && count > 0)) {
+    return SIMPLE_STACK_INVALID_ARGUMENT;
+  }
+  return translateExceptions([&] {
+    checkElementsFor(*handle->stack, count);
+    for (int i = 0; i < count; i++) {
+      values[i] = handle->stack->pop();
+    }
+  });
+}
+
+// Call `function` on the top `count` elements, the top one first, without
+// popping them. `handle->kind` tells which storage the stack has.
+template <class T, class Handle, class Function>
+void forEachTop(const Handle *handle, int count, Function function) {
+  if (handle->kind == SIMPLE_STACK_ARRAY) {
+    const StackArray<T> &stack =
+        static_cast<const StackArray<T> &>(*handle->stack);
+    const T *top = stack.getArray() + stack.getNumberOfElements() - 1;
+    for (int i = 0; i < count; i++) {
+      function(top[-i]);
+    }
+  } else {
+    const Node<T> *node =
+        static_cast<const StackLinkedList<T> &>(*handle->stack).getTop();
+    for (int i = 0; i < count; i++) {
+      function(node->value);
+      node = node->next.get();
+    }
+  }
+}
+
+// Remove the top `count` elements without copying them out.
+template <class T>
+void drop(Stack<T> &stack, int count) {
+  stack.rollback(StackMark{stack.getNumberOfElements() - count});
+}
+
+}  // namespace
+
+struct simple_stack_int64 : StackHandle<int64_t> {};
+struct simple_stack_double : StackHandle<double> {};
+struct simple_stack_bytes : StackHandle<std::string> {};
+
+////////////////////////////////////////////////////
+// int64_t
+int simple_stack_int64_create(int kind, int capacity,
+                              simple_stack_int64 **stack) {
+  return createStack<int64_t>(kind, capacity, stack);
+}
+
+int simple_stack_int64_copy(const simple_stack_int64 *other,
+                            simple_stack_int64 **stack) {
+  return copyStack<int64_t>(other, stack);
+}
+
+void simple_stack_int64_destroy(simple_stack_int64 *stack) { delete stack; }
+
+int simple_stack_int64_capacity(const simple_stack_int64 *stack) {
+  return stack->stack->getCapacity();
+}
+
+int simple_stack_int64_size(const simple_stack_int64 *stack) {
+  return stack->stack->getNumberOfElements();
+}
+
+int simple_stack_int64_push(simple_stack_int64 *stack, int64_t value) {
+  return translateExceptions([&] { stack->stack->push(value); });
+}
+
+int simple_stack_int64_pop(simple_stack_int64 *stack, int64_t *value) {
+  return translateExceptions([&] { *value = stack->stack->pop(); });
+}
+
+int simple_stack_int64_push_many(simple_stack_int64 *stack,
+                                 const int64_t *values, int count) {
+  return pushMany(stack, values, count);
+}
+
+int simple_stack_int64_pop_many(simple_stack_int64 *stack, int64_t *values,
+                                int count) {
+  return popMany(stack, values, count);
+}
+
+////////////////////////////////////////////////////
+// double
+int simple_stack_double_create(int kind, int capacity,
+                               simple_stack_double **stack) {
+  return createStack<double>(kind, capacity, stack);
+}
+
+int simple_stack_double_copy(const simple_stack_double *other,
+                             simple_stack_double **stack) {
+  return copyStack<double>(other, stack);
+}
+
+void simple_stack_double_destroy(simple_stack_double *stack) { delete stack; }
+
+int simple_stack_double_capacity(const simple_stack_double *stack) {
+  return stack->stack->getCapacity();
+}
+
+int simple_stack_double_size(const simple_stack_double *stack) {
+  return stack->stack->getNumberOfElements();
+}
+
+int simple_stack_double_push(simple_stack_double *stack, double value) {
+  return translateExceptions([&] { stack->stack->push(value); });
+}
+
+int simple_stack_double_pop(simple_stack_double *stack, double *value) {
+  return translateExceptions([&] { *value = stack->stack->pop(); });
+}
+
+int simple_stack_double_push_many(simple_stack_double *stack,
+                                  const double *values, int count) {
+  return pushMany(stack, values, count);
+}
+
+int simple_stack_double_pop_many(simple_stack_double *stack, double *values,
+                                 int count) {
+  return popMany(stack, values, count);
+}
+
+////////////////////////////////////////////////////
+// Byte strings
+int simple_stack_bytes_create(int kind, int capacity,
+                              simple_stack_bytes **stack) {
+  return createStack<std::string>(kind, capacity, stack);
+}
+
+int simple_stack_bytes_copy(const simple_stack_bytes *other,
+                            simple_stack_bytes **stack) {
+  return copyStack<std::string>(other, stack);
+}
+
+void simple_stack_bytes_destroy(simple_stack_bytes *stack) { delete stack; }
+
+int simple_stack_bytes_capacity(const simple_stack_bytes *stack) {
+  return stack->stack->getCapacity();
+}
+
+int simple_stack_bytes_size(const simple_stack_bytes *stack) {
+  return stack->stack->getNumberOfElements();
+}
+
+int simple_stack_bytes_push(simple_stack_bytes *stack, const char *data,
+                            size_t size) {
+  if (data == nullptr && size > 0) {
+    return SIMPLE_STACK_INVALID_ARGUMENT;
+  }
+  return translateExceptions(
+      [&] { stack->stack->push(std::string(data, size)); });
+}
+
+int simple_stack_bytes_pop(simple_stack_bytes *stack, char *buffer,
+                           size_t bufferSize, size_t *size) {
+  if (size == nullptr) {
+    return SIMPLE_STACK_INVALID_ARGUMENT;
+  }
+  int status = SIMPLE_STACK_OK;
+  int result = translateExceptions([&] {
+    checkElementsFor(*stack->stack, 1);
+    forEachTop<std::string>(stack, 1, [&](const std::string &value) {
+      *size = value.size();
+      if (*size > bufferSize) {
+        status = SIMPLE_STACK_BUFFER_TOO_SMALL;
+        return;
+      }
+      std::memcpy(buffer, value.data(), value.size());
+    });
+    if (status == SIMPLE_STACK_OK) {
+      drop(*stack->stack, 1);
+    }
+  });
+  return result != SIMPLE_STACK_OK ? result : status;
+}
+
+int simple_stack_bytes_push_many(simple_stack_bytes *stack,
+                                 const char *const *data, const size_t *sizes,
+                                 int count) {
+  if (count < 0 || ((data == nullptr || sizes == nullptr) && count > 0)) {
+    return SIMPLE_STACK_INVALID_ARGUMENT;
+  }
+  return translateExceptions([&] {
+    checkRoomFor(*stack->stack, count);
+    for (int i = 0; i < count; i++) {
+      stack->stack->push(std::string(data[i], sizes[i]));
+    }
+  });
+}
+
+int simple_stack_bytes_pop_many(simple_stack_bytes *stack, char *buffer,
+                                size_t bufferSize, size_t *sizes, int count,
+                                size_t *totalSize) {
+  if (count < 0 || totalSize == nullptr || (sizes == nullptr && count > 0)) {
+    return SIMPLE_STACK_INVALID_ARGUMENT;
+  }
+  int status = SIMPLE_STACK_OK;
+  int result = translateExceptions([&] {
+    checkElementsFor(*stack->stack, count);
+    // Size the elements up in place first, so that nothing has to be put back
+    // when they do not fit.
+    *totalSize = 0;
+    forEachTop<std::string>(stack, count, [&](const std::string &value) {
+      *totalSize += value.size();
+    });
+    if (*totalSize > bufferSize) {
+      status = SIMPLE_STACK_BUFFER_TOO_SMALL;
+      return;
+    }
+
+    size_t offset = 0;
+    int i = 0;
+    forEachTop<std::string>(stack, count, [&](const std::string &value) {
+      std::memcpy(buffer + offset, value.data(), value.size());
+      sizes[i++] = value.size();
+      offset += value.size();
+    });
+    drop(*stack->stack, count);
+  });
+  return result != SIMPLE_STACK_OK ? result : status;
+}
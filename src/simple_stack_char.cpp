@@ -0,0 +1,8 @@
+#include <cstdint>
+#include <string>
+
+#include "simple_stack.h"
+
+template class Stack<char>;
+template class StackArray<char>;
+template class StackLinkedList<char>;
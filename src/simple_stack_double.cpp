@@ -0,0 +1,8 @@
+#include <cstdint>
+#include <string>
+
+#include "simple_stack.h"
+
+template class Stack<double>;
+template class StackArray<double>;
+template class StackLinkedList<double>;
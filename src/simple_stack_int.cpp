@@ -0,0 +1,8 @@
+#include <cstdint>
+#include <string>
+
+#include "simple_stack.h"
+
+template class Stack<int>;
+template class StackArray<int>;
+template class StackLinkedList<int>;
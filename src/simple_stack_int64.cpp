@@ -0,0 +1,8 @@
+#include <cstdint>
+#include <string>
+
+#include "simple_stack.h"
+
+template class Stack<std::int64_t>;
+template class StackArray<std::int64_t>;
+template class StackLinkedList<std::int64_t>;
@@ -0,0 +1,8 @@
+#include <cstdint>
+#include <string>
+
+#include "simple_stack.h"
+
+template class Stack<std::string>;
+template class StackArray<std::string>;
+template class StackLinkedList<std::string>;
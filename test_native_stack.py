@@ -0,0 +1,107 @@
+"""Runs the `test_stack.py` suite against `native_stack.py`.
+
+The tests are inherited unchanged; only the classes they instantiate are
+swapped for the native ones. Tests that inspect the node objects of the
+pure-Python linked list have no native counterpart and are skipped.
+"""
+
+import unittest
+
+import native_stack
+import test_stack
+from stack import StackEmptyError, StackFullError, StackInvalidSizeError
+
+_PYTHON_NODE_INTERNALS = "inspects the Python node objects of stack.StackLinkedList"
+
+
+class _NativeClasses:
+    def setUp(self):
+        self._saved = (test_stack.StackList, test_stack.StackLinkedList)
+        test_stack.StackList = native_stack.StackList
+        test_stack.StackLinkedList = native_stack.StackLinkedList
+
+    def tearDown(self):
+        test_stack.StackList, test_stack.StackLinkedList = self._saved
+
+
+class TestNativeStackList(_NativeClasses, test_stack.TestStackList):
+    pass
+
+
+class TestNativeStackLinkedList(_NativeClasses, test_stack.TestStackLinkedList):
+    for _name in (
+        "test_head_is_none",
+        "test_stack_is_none",
+        "test_push_one",
+        "test_push_one_head_stack_is_same",
+        "test_push_head_stack_is_not_same",
+        "test_pop",
+        "test_pop_tail_next_is_none",
+        "test_move_constructor",
+        "test_copy_constructor",
+    ):
+        locals()[_name] = unittest.skip(_PYTHON_NODE_INTERNALS)(
+            getattr(test_stack.TestStackLinkedList, _name)
+        )
+    del _name
+
+
+class TestNativeOnly(unittest.TestCase):
+    def test_pop_order(self):
+        for cls in (native_stack.StackList, native_stack.StackLinkedList):
+            stack = cls(3)
+            for i in range(3):
+                stack.push(i)
+            self.assertEqual([stack.pop() for _ in range(3)], [2, 1, 0])
+
+    def test_move_constructor(self):
+        s1 = native_stack.StackLinkedList(10)
+        s1.push(1)
+        s2 = native_stack.StackLinkedList.move_constructor(s1)
+        self.assertEqual(s2.as_tuple, (1,))
+        self.assertEqual(len(s1), 0)
+        self.assertTrue(s1._is_empty)
+
+    def test_copy_constructor(self):
+        s1 = native_stack.StackLinkedList(10)
+        s1.push_many(range(5))
+        s2 = native_stack.StackLinkedList.copy_constructor(s1)
+        self.assertEqual(s1, s2)
+        s2.pop()
+        self.assertNotEqual(s1, s2)
+
+    def test_push_pop_many(self):
+        stack = native_stack.StackList(10)
+        stack.push_many(range(8))
+        with self.assertRaises(StackFullError):
+            stack.push_many(range(3))
+        self.assertEqual(len(stack), 8)
+        self.assertEqual(stack.pop_many(3), [7, 6, 5])
+        with self.assertRaises(StackEmptyError):
+            stack.pop_many(6)
+        self.assertEqual(len(stack), 5)
+
+    def test_double(self):
+        stack = native_stack.StackLinkedList(10, native_stack.DOUBLE)
+        stack.push(1.5)
+        stack.push_many([2.5, 3.5])
+        self.assertEqual(stack.pop(), 3.5)
+        self.assertEqual(stack.pop_many(2), [2.5, 1.5])
+
+    def test_bytes(self):
+        stack = native_stack.StackList(10, native_stack.BYTES)
+        long_value = b"x" * 1000
+        stack.push(b"a\x00b")
+        stack.push(long_value)
+        stack.push_many([b"", long_value, b"c"])
+        self.assertEqual(stack.pop(), b"c")
+        self.assertEqual(stack.pop_many(3), [long_value, b"", long_value])
+        self.assertEqual(stack.pop(), b"a\x00b")
+
+    def test_invalid_size_error(self):
+        with self.assertRaises(StackInvalidSizeError):
+            native_stack.StackList(2**31)
+
+
+if __name__ == "__main__":
+    unittest.main()
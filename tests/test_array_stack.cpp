@@ -1,11 +1,33 @@
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <mutex>
+#include <set>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "simple_stack.h"
 
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+// Resident set size of this process in bytes, or -1 where it is unknown.
+static long long getResidentBytes() {
+#if defined(__linux__)
+  std::ifstream statm("/proc/self/statm");
+  long long size, resident;
+  if (statm >> size >> resident) {
+    return resident * sysconf(_SC_PAGESIZE);
+  }
+#endif
+  return -1;
+}
+
 TEST(StackArrayTest, HandlesConstructor) {
   StackArray<int> stack(10);
   EXPECT_EQ(stack.getCapacity(), 10);
@@ -189,6 +211,137 @@ TEST(StackArrayTest, HandlesCopyAssignment) {
   }
 }
 
+TEST(StackArrayTest, HandlesCopyAssignmentReusingStorage) {
+  StackArray<int> s1(10);
+  StackArray<int> s2(10);
+  for (int i = 0; i < 10; i++) {
+    s1.push(i);
+    s2.push(-i);
+  }
+  s1.pop();
+  int *storage = s2.getArray();
+  s2 = s1;
+  EXPECT_EQ(s2.getArray(), storage);
+  EXPECT_EQ(s2.getNumberOfElements(), 9);
+  for (int i = 8; i >= 0; i--) {
+    EXPECT_EQ(s2.pop(), i);
+  }
+}
+
+// Copy assignment throws once `throwOnCopy` is set.
+struct ThrowingElement {
+  static bool throwOnCopy;
+  int value = 0;
+  ThrowingElement() = default;
+  ThrowingElement(int value) : value(value) {}
+  ThrowingElement(const ThrowingElement &other) = default;
+  ThrowingElement &operator=(const ThrowingElement &other) {
+    if (throwOnCopy) {
+      throw std::runtime_error("copy failed");
+    }
+    value = other.value;
+    return *this;
+  }
+};
+
+bool ThrowingElement::throwOnCopy = false;
+
+TEST(StackArrayTest, HandlesCopyAssignmentThrowing) {
+  StackArray<ThrowingElement> s1(10);
+  StackArray<ThrowingElement> s2(5);
+  for (int i = 0; i < 5; i++) {
+    s1.push(ThrowingElement(i));
+    s2.push(ThrowingElement(-i));
+  }
+  ThrowingElement::throwOnCopy = true;
+  EXPECT_THROW(s2 = s1, std::runtime_error);
+  ThrowingElement::throwOnCopy = false;
+
+  // The target is left as it was.
+  EXPECT_EQ(s2.getCapacity(), 5);
+  EXPECT_EQ(s2.getNumberOfElements(), 5);
+  for (int i = 4; i >= 0; i--) {
+    EXPECT_EQ(s2.pop().value, -i);
+  }
+}
+
+TEST(StackArrayTest, HandlesCloneParallel) {
+  int size = 100000;
+  StackArray<std::string> s1(size);
+  for (int i = 0; i < size; i++) {
+    s1.push(std::to_string(i));
+  }
+  for (int numberOfThreads : {1, 2, 3, 8}) {
+    StackArray<std::string> s2 = s1.cloneParallel(numberOfThreads);
+    EXPECT_EQ(s2.getCapacity(), size);
+    EXPECT_EQ(s2.getNumberOfElements(), size);
+    for (int i = size - 1; i >= 0; i--) {
+      ASSERT_EQ(s2.pop(), std::to_string(i));
+    }
+  }
+  EXPECT_EQ(s1.peek(), std::to_string(size - 1));
+  EXPECT_THROW(s1.cloneParallel(0), std::invalid_argument);
+
+  // More threads than elements
+  StackArray<std::string> s3(4);
+  s3.push("a");
+  StackArray<std::string> s4 = s3.cloneParallel(16);
+  EXPECT_EQ(s4.pop(), "a");
+}
+
+// Records the threads that copy-assign it.
+struct ThreadRecordingElement {
+  static std::mutex mutex;
+  static std::set<std::thread::id> threads;
+  ThreadRecordingElement &operator=(const ThreadRecordingElement &) {
+    std::lock_guard<std::mutex> lock(mutex);
+    threads.insert(std::this_thread::get_id());
+    return *this;
+  }
+};
+
+std::mutex ThreadRecordingElement::mutex;
+std::set<std::thread::id> ThreadRecordingElement::threads;
+
+TEST(StackArrayTest, HandlesSmallCopyOnOneThread) {
+  // However slow the elements are to copy, a few thousand of them are not
+  // worth threads unless asked for.
+  StackArray<ThreadRecordingElement> s1(4096);
+  for (int i = 0; i < 4096; i++) {
+    s1.push(ThreadRecordingElement());
+  }
+  ThreadRecordingElement::threads.clear();
+  StackArray<ThreadRecordingElement> s2 = s1;
+  EXPECT_EQ(s2.getNumberOfElements(), 4096);
+  ASSERT_EQ(ThreadRecordingElement::threads.size(), 1u);
+  EXPECT_EQ(*ThreadRecordingElement::threads.begin(),
+            std::this_thread::get_id());
+}
+
+TEST(StackArrayTest, HandlesLargeCopy) {
+  // Large enough to be copied on several threads where there are cores.
+  int size = 4 << 20;
+  StackArray<std::int64_t> s1(size);
+  for (int i = 0; i < size; i++) {
+    s1.push(i);
+  }
+  StackArray<std::int64_t> s2 = s1;
+  StackArray<std::int64_t> s3(size);
+  s3 = s1;
+  StackArray<std::vector<int>> v1(8);
+  for (int i = 0; i < 8; i++) {
+    v1.push(std::vector<int>(1 << 18, i));
+  }
+  StackArray<std::vector<int>> v2 = v1;
+  for (int i = size - 1; i >= 0; i--) {
+    ASSERT_EQ(s2.pop(), i);
+    ASSERT_EQ(s3.pop(), i);
+  }
+  for (int i = 7; i >= 0; i--) {
+    EXPECT_EQ(v2.pop(), std::vector<int>(1 << 18, i));
+  }
+}
+
 TEST(StackArrayTest, HandlesMoveConstructor) {
   int size = 10;
   StackArray<int> s1(size);
@@ -228,6 +381,188 @@ TEST(StackArrayTest, HandlesMoveAssignment) {
   }
 }
 
+TEST(StackArrayTest, HandlesMarkRollback) {
+  StackArray<int> stack(10);
+  stack.push(0);
+  stack.push(1);
+  StackMark mark = stack.mark();
+  for (int i = 2; i < 10; i++) {
+    stack.push(i);
+  }
+  stack.rollback(mark);
+  EXPECT_EQ(stack.getNumberOfElements(), 2);
+  EXPECT_EQ(stack.peek(), 1);
+  stack.push(5);
+  EXPECT_EQ(stack.pop(), 5);
+}
+
+TEST(StackArrayTest, HandlesNestedMarks) {
+  StackArray<std::string> stack(10);
+  stack.push("a");
+  StackMark outer = stack.mark();
+  stack.push("b");
+  StackMark inner = stack.mark();
+  stack.push("c");
+  stack.rollback(inner);
+  EXPECT_EQ(stack.peek(), "b");
+  stack.push("d");
+  stack.rollback(outer);
+  EXPECT_EQ(stack.getNumberOfElements(), 1);
+  EXPECT_EQ(stack.peek(), "a");
+  // The inner mark is now above the top of the stack.
+  EXPECT_THROW(stack.rollback(inner), StackInvalidMarkError);
+  stack.rollback(stack.mark());
+  EXPECT_EQ(stack.getNumberOfElements(), 1);
+}
+
+TEST(StackArrayTest, HandlesReset) {
+  StackArray<std::string> stack(3);
+  stack.push("a");
+  stack.push("b");
+  stack.reset();
+  EXPECT_TRUE(stack.isEmpty());
+  EXPECT_EQ(stack.getCapacity(), 3);
+  EXPECT_EQ(stack.getHighWaterMark(), 0);
+  for (int i = 0; i < 3; i++) {
+    stack.push(std::to_string(i));
+  }
+  EXPECT_TRUE(stack.isFull());
+  EXPECT_EQ(stack.pop(), "2");
+}
+
+TEST(StackArrayTest, HandlesShrinkToFit) {
+  StackArray<int> stack(100000);
+  for (int i = 0; i < 100000; i++) {
+    stack.push(i);
+  }
+  for (int i = 0; i < 99990; i++) {
+    stack.pop();
+  }
+  EXPECT_EQ(stack.getHighWaterMark(), 100000);
+  stack.shrinkToFit();
+  EXPECT_EQ(stack.getHighWaterMark(), 10);
+  EXPECT_EQ(stack.getCapacity(), 100000);
+  for (int i = 9; i >= 0; i--) {
+    EXPECT_EQ(stack.pop(), i);
+  }
+  // The decommitted slots are usable again.
+  for (int i = 0; i < 100000; i++) {
+    stack.push(i);
+  }
+  EXPECT_EQ(stack.peek(), 99999);
+}
+
+TEST(StackArrayTest, HandlesShrinkPolicy) {
+  StackArray<int> stack(1000);
+  stack.setShrinkPolicy(StackShrinkPolicy{0.5, 3});
+  for (int i = 0; i < 1000; i++) {
+    stack.push(i);
+  }
+  // Popping down to half of the high-water mark does not count yet.
+  for (int i = 0; i < 500; i++) {
+    stack.pop();
+  }
+  EXPECT_EQ(stack.getHighWaterMark(), 1000);
+  stack.pop();
+  stack.pop();
+  EXPECT_EQ(stack.getHighWaterMark(), 1000);
+  stack.pop();
+  EXPECT_EQ(stack.getHighWaterMark(), 497);
+  EXPECT_EQ(stack.peek(), 496);
+
+  // Going back above the fraction restarts the count.
+  stack.push(0);
+  stack.push(0);
+  stack.pop();
+  stack.pop();
+  EXPECT_EQ(stack.getHighWaterMark(), 499);
+}
+
+// Counts default constructions, which `shrinkToFit()` does for every slot it
+// resets. The string keeps it from being trivially copyable, so slots are
+// reset rather than decommitted.
+struct CountingElement {
+  static int numberOfDefaultConstructions;
+  std::string value;
+  CountingElement() { numberOfDefaultConstructions++; }
+};
+
+int CountingElement::numberOfDefaultConstructions = 0;
+
+TEST(StackArrayTest, HandlesShrinkPolicyOnlyForPops) {
+  {
+    StackArray<CountingElement> stack(100);
+    stack.setShrinkPolicy(StackShrinkPolicy{1.0, 1});
+    for (int i = 0; i < 100; i++) {
+      stack.push(CountingElement());
+    }
+    CountingElement::numberOfDefaultConstructions = 0;
+    stack.pop();
+    EXPECT_EQ(CountingElement::numberOfDefaultConstructions, 1);
+
+    CountingElement::numberOfDefaultConstructions = 0;
+    stack.clear();
+    EXPECT_EQ(CountingElement::numberOfDefaultConstructions, 0);
+  }
+  {
+    StackArray<CountingElement> stack(100);
+    stack.setShrinkPolicy(StackShrinkPolicy{1.0, 1});
+    for (int i = 0; i < 100; i++) {
+      stack.push(CountingElement());
+    }
+    CountingElement::numberOfDefaultConstructions = 0;
+  }
+  // Destruction does not shrink either.
+  EXPECT_EQ(CountingElement::numberOfDefaultConstructions, 0);
+}
+
+TEST(StackArrayTest, HandlesShrinkReleasingMemory) {
+  const long long bytes = 64 << 20;
+  const int capacity = static_cast<int>(bytes / sizeof(std::int64_t));
+  if (getResidentBytes() < 0) {
+    GTEST_SKIP() << "The resident set size is unknown on this platform.";
+  }
+  StackArray<std::int64_t> stack(capacity);
+  long long before = getResidentBytes();
+  for (int i = 0; i < capacity; i++) {
+    stack.push(i);
+  }
+  long long full = getResidentBytes();
+  EXPECT_GT(full - before, bytes / 2);
+
+  while (stack.getNumberOfElements() > 1000) {
+    stack.pop();
+  }
+  stack.shrinkToFit();
+  long long drained = getResidentBytes();
+  EXPECT_LT(drained - before, bytes / 4);
+  EXPECT_EQ(stack.peek(), 999);
+}
+
+TEST(StackArrayTest, HandlesShrinkPolicyReleasingMemory) {
+  const long long bytes = 64 << 20;
+  const int capacity = static_cast<int>(bytes / sizeof(std::int64_t));
+  if (getResidentBytes() < 0) {
+    GTEST_SKIP() << "The resident set size is unknown on this platform.";
+  }
+  StackArray<std::int64_t> stack(capacity);
+  stack.setShrinkPolicy(StackShrinkPolicy{0.25, 1000});
+  long long before = getResidentBytes();
+  for (int i = 0; i < capacity; i++) {
+    stack.push(i);
+  }
+  while (stack.getNumberOfElements() > capacity / 8) {
+    stack.pop();
+  }
+  long long drained = getResidentBytes();
+  EXPECT_LT(drained - before, bytes / 2);
+  EXPECT_LT(stack.getHighWaterMark(), capacity / 4);
+
+  stack.reset();
+  EXPECT_LT(getResidentBytes() - before, bytes / 16);
+  EXPECT_EQ(stack.getCapacity(), capacity);
+}
+
 #ifdef ENABLE_TIME_CONSUMING_TESTS
 // Test large elements
 TEST(StackArrayTest, HandlesLargeSizeIntVector) {
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "async_executor.h"
+#include "async_stack.h"
+
+DetachedTask pushAll(SingleThreadExecutor &executor, AsyncStack<int> &stack,
+                     std::vector<int> items) {
+  co_await executor.schedule();
+  for (int item : items) {
+    co_await stack.push(item);
+  }
+}
+
+DetachedTask popInto(SingleThreadExecutor &executor, AsyncStack<int> &stack,
+                     int count, std::vector<int> &popped) {
+  co_await executor.schedule();
+  for (int i = 0; i < count; i++) {
+    popped.push_back(co_await stack.pop());
+  }
+}
+
+TEST(AsyncStackTest, HandlesInvalidCapacityError) {
+  EXPECT_THROW(AsyncStack<int> stack(0), StackInvalidCapacityError);
+}
+
+TEST(AsyncStackTest, HandlesPushPop) {
+  SingleThreadExecutor executor;
+  AsyncStack<int> stack(10);
+  std::vector<int> popped;
+  pushAll(executor, stack, {0, 1, 2});
+  executor.run();
+  EXPECT_EQ(stack.getNumberOfElements(), 3);
+
+  popInto(executor, stack, 3, popped);
+  executor.run();
+  EXPECT_EQ(popped, (std::vector<int>{2, 1, 0}));
+  EXPECT_EQ(stack.getNumberOfElements(), 0);
+}
+
+TEST(AsyncStackTest, HandlesPopSuspendsWhileEmpty) {
+  SingleThreadExecutor executor;
+  AsyncStack<int> stack(10);
+  std::vector<int> popped;
+  popInto(executor, stack, 2, popped);
+  executor.run();
+  // The consumer is suspended, not blocking the thread.
+  EXPECT_TRUE(popped.empty());
+
+  pushAll(executor, stack, {7});
+  executor.run();
+  EXPECT_EQ(popped, (std::vector<int>{7}));
+
+  pushAll(executor, stack, {8, 9});
+  executor.run();
+  EXPECT_EQ(popped, (std::vector<int>{7, 8}));
+  EXPECT_EQ(stack.getNumberOfElements(), 1);
+}
+
+TEST(AsyncStackTest, HandlesPushSuspendsWhileFull) {
+  SingleThreadExecutor executor;
+  AsyncStack<int> stack(2);
+  std::vector<int> popped;
+  pushAll(executor, stack, {0, 1, 2, 3});
+  executor.run();
+  EXPECT_EQ(stack.getNumberOfElements(), 2);
+
+  // Every pop frees a slot for the suspended producer.
+  popInto(executor, stack, 1, popped);
+  executor.run();
+  EXPECT_EQ(popped, (std::vector<int>{1}));
+  EXPECT_EQ(stack.getNumberOfElements(), 2);
+
+  popInto(executor, stack, 3, popped);
+  executor.run();
+  EXPECT_EQ(popped, (std::vector<int>{1, 2, 3, 0}));
+  EXPECT_EQ(stack.getNumberOfElements(), 0);
+}
+
+DetachedTask produce(ThreadPoolExecutor &executor, AsyncStack<long> &stack,
+                     int count, std::atomic<int> &finished) {
+  co_await executor.schedule();
+  for (int i = 1; i <= count; i++) {
+    co_await stack.push(i);
+  }
+  finished++;
+}
+
+DetachedTask consume(ThreadPoolExecutor &executor, AsyncStack<long> &stack,
+                     int count, std::atomic<long> &sum,
+                     std::atomic<int> &finished) {
+  co_await executor.schedule();
+  for (int i = 0; i < count; i++) {
+    sum += co_await stack.pop();
+  }
+  finished++;
+}
+
+TEST(AsyncStackTest, HandlesThreadPool) {
+  int numberOfTasks = 8;
+  int count = 10000;
+  AsyncStack<long> stack(16);
+  std::atomic<long> sum(0);
+  std::atomic<int> finished(0);
+  {
+    ThreadPoolExecutor executor(4);
+    for (int i = 0; i < numberOfTasks; i++) {
+      consume(executor, stack, count, sum, finished);
+      produce(executor, stack, count, finished);
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (finished < 2 * numberOfTasks &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+  }
+  EXPECT_EQ(finished, 2 * numberOfTasks);
+  EXPECT_EQ(sum, static_cast<long>(numberOfTasks) * count * (count + 1) / 2);
+  EXPECT_EQ(stack.getNumberOfElements(), 0);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -302,6 +302,55 @@ TEST(StackLinkedListTest, HandlesMoveAssignment) {
   }
 }
 
+TEST(StackLinkedListTest, HandlesMarkRollback) {
+  StackLinkedList<int> stack(10);
+  stack.push(0);
+  stack.push(1);
+  StackMark mark = stack.mark();
+  for (int i = 2; i < 10; i++) {
+    stack.push(i);
+  }
+  stack.rollback(mark);
+  EXPECT_EQ(stack.getNumberOfElements(), 2);
+  EXPECT_EQ(stack.peek(), 1);
+  stack.push(5);
+  EXPECT_EQ(stack.pop(), 5);
+}
+
+TEST(StackLinkedListTest, HandlesNestedMarks) {
+  StackLinkedList<std::string> stack(10);
+  stack.push("a");
+  StackMark outer = stack.mark();
+  stack.push("b");
+  StackMark inner = stack.mark();
+  stack.push("c");
+  stack.rollback(inner);
+  EXPECT_EQ(stack.peek(), "b");
+  stack.push("d");
+  stack.rollback(outer);
+  EXPECT_EQ(stack.getNumberOfElements(), 1);
+  EXPECT_EQ(stack.peek(), "a");
+  // The inner mark is now above the top of the stack.
+  EXPECT_THROW(stack.rollback(inner), StackInvalidMarkError);
+  stack.rollback(stack.mark());
+  EXPECT_EQ(stack.getNumberOfElements(), 1);
+}
+
+TEST(StackLinkedListTest, HandlesReset) {
+  StackLinkedList<std::string> stack(3);
+  stack.push("a");
+  stack.push("b");
+  stack.reset();
+  EXPECT_TRUE(stack.isEmpty());
+  EXPECT_EQ(stack.getTop(), nullptr);
+  EXPECT_EQ(stack.getCapacity(), 3);
+  for (int i = 0; i < 3; i++) {
+    stack.push(std::to_string(i));
+  }
+  EXPECT_TRUE(stack.isFull());
+  EXPECT_EQ(stack.pop(), "2");
+}
+
 #ifdef ENABLE_TIME_CONSUMING_TESTS
 // Test large elements
 TEST(StackLinkedListTest, HandlesLargeSizeIntVector) {
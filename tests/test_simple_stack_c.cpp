@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "simple_stack_c.h"
+
+// Exercises the C ABI the way `native_stack.py` does. The test is built with
+// AddressSanitizer where the compiler supports it, so stacks that are not
+// fully freed by `*_destroy` fail it with a leak report.
+
+TEST(SimpleStackCTest, HandlesInt64CreatePushDestroy) {
+  for (int kind : {SIMPLE_STACK_ARRAY, SIMPLE_STACK_LINKED_LIST}) {
+    simple_stack_int64 *stack = nullptr;
+    ASSERT_EQ(simple_stack_int64_create(kind, 1000, &stack), SIMPLE_STACK_OK);
+    for (int64_t i = 0; i < 1000; i++) {
+      ASSERT_EQ(simple_stack_int64_push(stack, i), SIMPLE_STACK_OK);
+    }
+    EXPECT_EQ(simple_stack_int64_push(stack, 0), SIMPLE_STACK_OVERFLOW);
+    EXPECT_EQ(simple_stack_int64_capacity(stack), 1000);
+    EXPECT_EQ(simple_stack_int64_size(stack), 1000);
+
+    int64_t value;
+    ASSERT_EQ(simple_stack_int64_pop(stack, &value), SIMPLE_STACK_OK);
+    EXPECT_EQ(value, 999);
+    // Destroyed with elements still on it
+    simple_stack_int64_destroy(stack);
+  }
+}
+
+TEST(SimpleStackCTest, HandlesDoubleCopy) {
+  for (int kind : {SIMPLE_STACK_ARRAY, SIMPLE_STACK_LINKED_LIST}) {
+    simple_stack_double *stack = nullptr;
+    ASSERT_EQ(simple_stack_double_create(kind, 10, &stack), SIMPLE_STACK_OK);
+    double values[3] = {0.5, 1.5, 2.5};
+    ASSERT_EQ(simple_stack_double_push_many(stack, values, 3),
+              SIMPLE_STACK_OK);
+
+    simple_stack_double *copy = nullptr;
+    ASSERT_EQ(simple_stack_double_copy(stack, &copy), SIMPLE_STACK_OK);
+    simple_stack_double_destroy(stack);
+
+    double popped[3];
+    ASSERT_EQ(simple_stack_double_pop_many(copy, popped, 3), SIMPLE_STACK_OK);
+    EXPECT_EQ(popped[0], 2.5);
+    EXPECT_EQ(popped[2], 0.5);
+    EXPECT_EQ(simple_stack_double_pop(copy, popped), SIMPLE_STACK_UNDERFLOW);
+    simple_stack_double_destroy(copy);
+  }
+}
+
+TEST(SimpleStackCTest, HandlesBytesCreatePushDestroy) {
+  for (int kind : {SIMPLE_STACK_ARRAY, SIMPLE_STACK_LINKED_LIST}) {
+    simple_stack_bytes *stack = nullptr;
+    ASSERT_EQ(simple_stack_bytes_create(kind, 100, &stack), SIMPLE_STACK_OK);
+    for (int i = 0; i < 100; i++) {
+      // Longer than the small-string buffer, so every element owns memory.
+      std::string value(64, static_cast<char>('a' + i % 26));
+      ASSERT_EQ(simple_stack_bytes_push(stack, value.data(), value.size()),
+                SIMPLE_STACK_OK);
+    }
+
+    char buffer[64];
+    size_t size;
+    EXPECT_EQ(simple_stack_bytes_pop(stack, buffer, 10, &size),
+              SIMPLE_STACK_BUFFER_TOO_SMALL);
+    ASSERT_EQ(simple_stack_bytes_pop(stack, buffer, sizeof(buffer), &size),
+              SIMPLE_STACK_OK);
+    EXPECT_EQ(std::string(buffer, size), std::string(64, 'a' + 99 % 26));
+
+    simple_stack_bytes *copy = nullptr;
+    ASSERT_EQ(simple_stack_bytes_copy(stack, &copy), SIMPLE_STACK_OK);
+    EXPECT_EQ(simple_stack_bytes_size(copy), 99);
+    simple_stack_bytes_destroy(copy);
+    simple_stack_bytes_destroy(stack);
+  }
+}
+
+TEST(SimpleStackCTest, HandlesBytesPopManyBufferTooSmall) {
+  for (int kind : {SIMPLE_STACK_ARRAY, SIMPLE_STACK_LINKED_LIST}) {
+    simple_stack_bytes *stack = nullptr;
+    ASSERT_EQ(simple_stack_bytes_create(kind, 10, &stack), SIMPLE_STACK_OK);
+    for (int i = 0; i < 3; i++) {
+      std::string value(100 * (i + 1), static_cast<char>('a' + i));
+      ASSERT_EQ(simple_stack_bytes_push(stack, value.data(), value.size()),
+                SIMPLE_STACK_OK);
+    }
+
+    // Nothing is popped when the elements do not fit.
+    char buffer[600];
+    size_t sizes[3];
+    size_t totalSize = 0;
+    EXPECT_EQ(simple_stack_bytes_pop_many(stack, buffer, 500, sizes, 3,
+                                          &totalSize),
+              SIMPLE_STACK_BUFFER_TOO_SMALL);
+    EXPECT_EQ(totalSize, 600u);
+    EXPECT_EQ(simple_stack_bytes_size(stack), 3);
+
+    ASSERT_EQ(simple_stack_bytes_pop_many(stack, buffer, sizeof(buffer), sizes,
+                                          2, &totalSize),
+              SIMPLE_STACK_OK);
+    EXPECT_EQ(totalSize, 500u);
+    EXPECT_EQ(sizes[0], 300u);
+    EXPECT_EQ(sizes[1], 200u);
+    EXPECT_EQ(std::string(buffer, 300), std::string(300, 'c'));
+    EXPECT_EQ(std::string(buffer + 300, 200), std::string(200, 'b'));
+    EXPECT_EQ(simple_stack_bytes_size(stack), 1);
+    EXPECT_EQ(simple_stack_bytes_pop_many(stack, buffer, sizeof(buffer), sizes,
+                                          2, &totalSize),
+              SIMPLE_STACK_UNDERFLOW);
+    simple_stack_bytes_destroy(stack);
+  }
+}
+
+TEST(SimpleStackCTest, HandlesInvalidArguments) {
+  simple_stack_int64 *stack = nullptr;
+  EXPECT_EQ(simple_stack_int64_create(SIMPLE_STACK_ARRAY, 0, &stack),
+            SIMPLE_STACK_INVALID_CAPACITY);
+  EXPECT_EQ(stack, nullptr);
+  EXPECT_EQ(simple_stack_int64_create(7, 10, &stack),
+            SIMPLE_STACK_INVALID_ARGUMENT);
+  EXPECT_EQ(simple_stack_int64_create(SIMPLE_STACK_ARRAY, 10, nullptr),
+            SIMPLE_STACK_INVALID_ARGUMENT);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
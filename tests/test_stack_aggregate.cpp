@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "stack_aggregate.h"
+
+TEST(StackAggregateTest, HandlesConstructor) {
+  StackMin<int> stack(10);
+  EXPECT_EQ(stack.getCapacity(), 10);
+  EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(StackAggregateTest, HandlesInvalidCapacityError) {
+  std::vector<int> stack_capacities = {-10, -1, 0};
+  for (int capacity : stack_capacities) {
+    EXPECT_THROW(StackMin<int> stack(capacity), StackInvalidCapacityError);
+  }
+}
+
+TEST(StackAggregateTest, HandlesPushPop) {
+  StackMin<int> stack(10);
+  for (int pushed = 0; pushed < 10; pushed++) {
+    stack.push(pushed);
+    EXPECT_EQ(stack.peek(), pushed);
+  }
+  for (int pushed = 9; pushed >= 0; pushed--) {
+    EXPECT_EQ(stack.pop(), pushed);
+  }
+}
+
+TEST(StackAggregateTest, HandlesMin) {
+  StackMin<int> stack(10);
+  std::vector<int> items = {5, 7, 3, 3, 8, 1, 9};
+  std::vector<int> pushed;
+  for (int item : items) {
+    stack.push(item);
+    pushed.push_back(item);
+    EXPECT_EQ(stack.getMin(), *std::min_element(pushed.begin(), pushed.end()));
+  }
+  while (pushed.empty() == false) {
+    EXPECT_EQ(stack.getMin(), *std::min_element(pushed.begin(), pushed.end()));
+    EXPECT_EQ(stack.pop(), pushed.back());
+    pushed.pop_back();
+  }
+}
+
+TEST(StackAggregateTest, HandlesMaxAndSum) {
+  StackMax<double> maxStack(10);
+  StackSum<double> sumStack(10);
+  std::vector<double> items = {1.5, -2.0, 4.0, 0.5};
+  double sum = 0;
+  double max = items[0];
+  for (double item : items) {
+    maxStack.push(item);
+    sumStack.push(item);
+    sum += item;
+    max = std::max(max, item);
+    EXPECT_EQ(maxStack.getMax(), max);
+    EXPECT_EQ(sumStack.getSum(), sum);
+  }
+}
+
+struct LongestString {
+  std::string operator()(const std::string &below,
+                         const std::string &value) const {
+    return value.size() > below.size() ? value : below;
+  }
+};
+
+TEST(StackAggregateTest, HandlesCustomMonoid) {
+  StackAggregate<std::string, LongestString> stack(10);
+  stack.push("ab");
+  stack.push("abcd");
+  stack.push("x");
+  EXPECT_EQ(stack.getAggregate(), "abcd");
+  stack.pop();
+  stack.pop();
+  EXPECT_EQ(stack.getAggregate(), "ab");
+}
+
+TEST(StackAggregateTest, HandlesEmptyErrors) {
+  StackMin<int> stack(10);
+  EXPECT_THROW(stack.pop(), StackUnderflowError);
+  EXPECT_THROW(stack.peek(), StackUnderflowError);
+  EXPECT_THROW(stack.getMin(), StackUnderflowError);
+}
+
+TEST(StackAggregateTest, HandlesFullError) {
+  StackMin<int> stack(10);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_NO_THROW(stack.push(i));
+  }
+  EXPECT_TRUE(stack.isFull());
+  EXPECT_THROW(stack.push(1), StackOverflowError);
+}
+
+TEST(StackAggregateTest, HandlesCopyConstructorAndAssignment) {
+  StackMin<int> s1(10);
+  for (int i = 10; i > 0; i--) {
+    s1.push(i);
+  }
+  StackMin<int> s2 = s1;
+  StackMin<int> s3(1);
+  s3 = s1;
+  EXPECT_EQ(s2.getNumberOfElements(), 10);
+  EXPECT_EQ(s3.getCapacity(), 10);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(s1.getMin(), s2.getMin());
+    EXPECT_EQ(s1.getMin(), s3.getMin());
+    EXPECT_EQ(s1.pop(), s2.pop());
+    s3.pop();
+  }
+}
+
+TEST(StackAggregateTest, HandlesMoveConstructorAndAssignment) {
+  StackMin<int> s1(10);
+  for (int i = 0; i < 10; i++) {
+    s1.push(i);
+  }
+  StackMin<int> s2 = std::move(s1);
+  EXPECT_EQ(s1.getNumberOfElements(), 0);
+  EXPECT_EQ(s1.getCapacity(), 0);
+  EXPECT_EQ(s2.getNumberOfElements(), 10);
+  EXPECT_EQ(s2.getCapacity(), 10);
+
+  StackMin<int> s3(1);
+  s3 = std::move(s2);
+  EXPECT_EQ(s2.getCapacity(), 0);
+  EXPECT_EQ(s3.getCapacity(), 10);
+  EXPECT_EQ(s3.getMin(), 0);
+  EXPECT_EQ(s3.pop(), 9);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "stack_arena.h"
+
+TEST(StackArenaTest, HandlesConstructor) {
+  StackArena<int> arena(100, 4);
+  EXPECT_EQ(arena.getCapacity(), 100);
+  EXPECT_EQ(arena.getNumberOfStacks(), 4);
+  EXPECT_TRUE(arena.isEmpty());
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(arena.getRegionCapacity(i), 25);
+    EXPECT_TRUE(arena.getStack(i).isEmpty());
+  }
+}
+
+TEST(StackArenaTest, HandlesInvalidCapacityError) {
+  EXPECT_THROW(StackArena<int> arena(0, 1), StackInvalidCapacityError);
+  EXPECT_THROW(StackArena<int> arena(10, 0), StackInvalidCapacityError);
+}
+
+TEST(StackArenaTest, HandlesInvalidIndex) {
+  StackArena<int> arena(10, 2);
+  EXPECT_THROW(arena.getStack(2), std::out_of_range);
+  EXPECT_THROW(arena.push(-1, 0), std::out_of_range);
+}
+
+TEST(StackArenaTest, HandlesPushPopPeek) {
+  StackArena<int> arena(30, 3);
+  std::vector<ArenaStack<int>> stacks;
+  for (int i = 0; i < 3; i++) {
+    stacks.push_back(arena.getStack(i));
+  }
+  for (int pushed = 0; pushed < 10; pushed++) {
+    for (int i = 0; i < 3; i++) {
+      stacks[i].push(pushed * 10 + i);
+      EXPECT_EQ(stacks[i].peek(), pushed * 10 + i);
+    }
+  }
+  EXPECT_TRUE(arena.isFull());
+  for (int popped = 9; popped >= 0; popped--) {
+    for (int i = 0; i < 3; i++) {
+      EXPECT_EQ(stacks[i].pop(), popped * 10 + i);
+    }
+  }
+  EXPECT_TRUE(arena.isEmpty());
+}
+
+TEST(StackArenaTest, HandlesEmptyPopPeekError) {
+  StackArena<int> arena(10, 2);
+  ArenaStack<int> stack = arena.getStack(1);
+  EXPECT_THROW(stack.pop(), StackUnderflowError);
+  EXPECT_THROW(stack.peek(), StackUnderflowError);
+  arena.getStack(0).push(1);
+  EXPECT_THROW(stack.pop(), StackUnderflowError);
+}
+
+TEST(StackArenaTest, HandlesRepackInsteadOfOverflow) {
+  int capacity = 100;
+  StackArena<int> arena(capacity, 4);
+  ArenaStack<int> greedy = arena.getStack(2);
+  arena.getStack(0).push(-1);
+  arena.getStack(3).push(-3);
+
+  // A single stack may take every slot the others do not use.
+  for (int pushed = 0; pushed < capacity - 2; pushed++) {
+    greedy.push(pushed);
+  }
+  EXPECT_GT(arena.getNumberOfRepacks(), 0);
+  EXPECT_TRUE(arena.isFull());
+  EXPECT_THROW(greedy.push(0), StackOverflowError);
+  EXPECT_THROW(arena.getStack(1).push(0), StackOverflowError);
+
+  EXPECT_EQ(arena.getStack(0).peek(), -1);
+  EXPECT_EQ(arena.getStack(3).peek(), -3);
+  for (int popped = capacity - 3; popped >= 0; popped--) {
+    EXPECT_EQ(greedy.pop(), popped);
+  }
+}
+
+TEST(StackArenaTest, HandlesInterleavedGrowth) {
+  // Stacks grow at different rates and force repacks in both directions.
+  int numberOfStacks = 5;
+  StackArena<std::string> arena(200, numberOfStacks);
+  std::vector<std::vector<std::string>> expected(numberOfStacks);
+  for (int round = 0; arena.isFull() == false; round++) {
+    int index = (round * round) % numberOfStacks;
+    std::string value = std::to_string(round);
+    arena.push(index, value);
+    expected[index].push_back(value);
+  }
+  EXPECT_GT(arena.getNumberOfRepacks(), 0);
+
+  for (int i = 0; i < numberOfStacks; i++) {
+    EXPECT_EQ(arena.getNumberOfElements(i), expected[i].size());
+    while (expected[i].empty() == false) {
+      EXPECT_EQ(arena.pop(i), expected[i].back());
+      expected[i].pop_back();
+    }
+  }
+  EXPECT_TRUE(arena.isEmpty());
+}
+
+TEST(StackArenaTest, HandlesClear) {
+  StackArena<int> arena(10, 2);
+  ArenaStack<int> s0 = arena.getStack(0);
+  ArenaStack<int> s1 = arena.getStack(1);
+  for (int i = 0; i < 3; i++) {
+    s0.push(i);
+    s1.push(i);
+  }
+  s0.clear();
+  EXPECT_TRUE(s0.isEmpty());
+  EXPECT_EQ(s1.getNumberOfElements(), 3);
+  EXPECT_EQ(arena.getNumberOfElements(), 3);
+  EXPECT_EQ(s0.getCapacity(), 10);
+}
+
+TEST(StackArenaTest, HandlesMarkRollback) {
+  StackArena<std::string> arena(20, 2);
+  ArenaStack<std::string> s0 = arena.getStack(0);
+  ArenaStack<std::string> s1 = arena.getStack(1);
+  s0.push("a");
+  s1.push("b");
+  StackMark mark = s0.mark();
+  for (int i = 0; i < 5; i++) {
+    s0.push(std::string(100, 'c'));
+  }
+  s0.rollback(mark);
+  EXPECT_EQ(s0.getNumberOfElements(), 1);
+  EXPECT_EQ(arena.getNumberOfElements(), 2);
+  EXPECT_EQ(s0.peek(), "a");
+  EXPECT_EQ(s1.peek(), "b");
+  EXPECT_THROW(s0.rollback(StackMark{2}), StackInvalidMarkError);
+}
+
+TEST(StackArenaTest, HandlesClearReleasingElements) {
+  StackArena<std::shared_ptr<int>> arena(10, 2);
+  ArenaStack<std::shared_ptr<int>> s0 = arena.getStack(0);
+  std::shared_ptr<int> value = std::make_shared<int>(1);
+  for (int i = 0; i < 3; i++) {
+    s0.push(value);
+  }
+  EXPECT_EQ(value.use_count(), 4);
+  s0.rollback(StackMark{1});
+  EXPECT_EQ(value.use_count(), 2);
+  s0.clear();
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "stack_blob.h"
+
+TEST(StackBlobTest, HandlesConstructor) {
+  StackBlob stack(10);
+  EXPECT_EQ(stack.getCapacity(), 10);
+  EXPECT_TRUE(stack.isEmpty());
+  EXPECT_EQ(stack.getNumberOfBytes(), 0);
+}
+
+TEST(StackBlobTest, HandlesInvalidCapacityError) {
+  std::vector<int> stack_capacities = {-10, -1, 0};
+  for (int capacity : stack_capacities) {
+    EXPECT_THROW(StackBlob stack(capacity), StackInvalidCapacityError);
+  }
+}
+
+TEST(StackBlobTest, HandlesPushPopString) {
+  StackBlob stack(10);
+  std::vector<std::string> items = {"school", "", "boy", std::string(1000, 'x'),
+                                    std::string("a\0b", 3)};
+  for (const std::string &item : items) {
+    stack.push(item);
+    EXPECT_EQ(stack.peek().toString(), item);
+  }
+  for (int i = static_cast<int>(items.size()) - 1; i >= 0; i--) {
+    EXPECT_EQ(stack.pop().toString(), items[i]);
+  }
+  EXPECT_TRUE(stack.isEmpty());
+  EXPECT_EQ(stack.getNumberOfBytes(), 0);
+}
+
+TEST(StackBlobTest, HandlesAlignedRecords) {
+  StackBlob stack(10);
+  std::vector<double> values = {1.5, 2.5, 3.5};
+  stack.push("abc");
+  stack.push(values.data(), values.size() * sizeof(double));
+  BlobView top = stack.peek();
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(top.data()) % 8, 0);
+  EXPECT_EQ(top.size(), values.size() * sizeof(double));
+  EXPECT_EQ(top.dataAs<double>()[2], 3.5);
+}
+
+TEST(StackBlobTest, HandlesPushOfOwnView) {
+  StackBlob stack(10);
+  stack.push("first");
+  // Both views point into the stack's own buffer.
+  stack.push(stack.peek());
+  stack.push(stack.pop());
+  EXPECT_EQ(stack.getNumberOfElements(), 2);
+  EXPECT_EQ(stack.pop().toString(), "first");
+  EXPECT_EQ(stack.pop().toString(), "first");
+}
+
+TEST(StackBlobTest, HandlesEmptyAndFullErrors) {
+  StackBlob stack(2);
+  EXPECT_THROW(stack.pop(), StackUnderflowError);
+  EXPECT_THROW(stack.peek(), StackUnderflowError);
+  stack.push("a");
+  stack.push("b");
+  EXPECT_TRUE(stack.isFull());
+  EXPECT_THROW(stack.push("c"), StackOverflowError);
+}
+
+TEST(StackBlobTest, HandlesMixedSizeIntVector) {
+  // The StackArray<std::vector<int>> version makes one allocation per
+  // element; here all records share one buffer.
+  int capacity = 2000;
+  StackBlob stack(capacity);
+  for (int i = 0; i < capacity; i++) {
+    std::vector<int> element(i, i);
+    stack.push(element.data(), element.size() * sizeof(int));
+  }
+  EXPECT_TRUE(stack.isFull());
+  for (int i = capacity - 1; i >= 0; i--) {
+    BlobView element = stack.pop();
+    ASSERT_EQ(element.size(), i * sizeof(int));
+    if (i > 0) {
+      EXPECT_EQ(element.dataAs<int>()[i - 1], i);
+    }
+  }
+  EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(StackBlobTest, HandlesCopyConstructorAndAssignment) {
+  StackBlob s1(10);
+  for (int i = 0; i < 10; i++) {
+    s1.push(std::to_string(i));
+  }
+  StackBlob s2 = s1;
+  StackBlob s3(1);
+  s3 = s1;
+  EXPECT_EQ(s2.getNumberOfElements(), 10);
+  EXPECT_EQ(s3.getCapacity(), 10);
+  for (int i = 9; i >= 0; i--) {
+    EXPECT_EQ(s2.pop().toString(), std::to_string(i));
+    EXPECT_EQ(s3.pop().toString(), std::to_string(i));
+  }
+  EXPECT_EQ(s1.getNumberOfElements(), 10);
+}
+
+TEST(StackBlobTest, HandlesMoveConstructorAndAssignment) {
+  StackBlob s1(10);
+  s1.push("a");
+  StackBlob s2 = std::move(s1);
+  EXPECT_EQ(s1.getCapacity(), 0);
+  EXPECT_EQ(s1.getNumberOfElements(), 0);
+  EXPECT_EQ(s2.peek().toString(), "a");
+
+  StackBlob s3(1);
+  s3 = std::move(s2);
+  EXPECT_EQ(s2.getCapacity(), 0);
+  EXPECT_EQ(s3.getCapacity(), 10);
+  EXPECT_EQ(s3.pop().toString(), "a");
+}
+
+TEST(StackBlobTest, HandlesMarkRollback) {
+  StackBlob stack(10);
+  stack.push("keep");
+  StackMark mark = stack.mark();
+  stack.push("drop");
+  stack.push("drop too");
+  stack.rollback(mark);
+  EXPECT_EQ(stack.peek().toString(), "keep");
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "stack_flat_combining.h"
+
+TEST(StackFlatCombiningTest, HandlesConstructor) {
+  StackFlatCombining<int> stack(10);
+  EXPECT_EQ(stack.getCapacity(), 10);
+  EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(StackFlatCombiningTest, HandlesConstQueries) {
+  const StackFlatCombining<int> stack(10);
+  EXPECT_TRUE(stack.isEmpty());
+  EXPECT_FALSE(stack.isFull());
+  EXPECT_EQ(stack.getNumberOfElements(), 0);
+}
+
+TEST(StackFlatCombiningTest, HandlesInvalidCapacityError) {
+  EXPECT_THROW(StackFlatCombining<int> stack(0), StackInvalidCapacityError);
+  EXPECT_THROW(StackFlatCombining<int> stack(10, 0),
+               StackInvalidCapacityError);
+}
+
+TEST(StackFlatCombiningTest, HandlesPushPopPeek) {
+  StackFlatCombining<std::string> stack(10);
+  for (int pushed = 0; pushed < 10; pushed++) {
+    stack.push(std::to_string(pushed));
+    EXPECT_EQ(stack.peek(), std::to_string(pushed));
+  }
+  EXPECT_TRUE(stack.isFull());
+  for (int pushed = 9; pushed >= 0; pushed--) {
+    EXPECT_EQ(stack.pop(), std::to_string(pushed));
+  }
+}
+
+TEST(StackFlatCombiningTest, HandlesEmptyAndFullErrors) {
+  StackFlatCombining<int> stack(2);
+  EXPECT_THROW(stack.pop(), StackUnderflowError);
+  EXPECT_THROW(stack.peek(), StackUnderflowError);
+  stack.push(1);
+  stack.push(2);
+  EXPECT_THROW(stack.push(3), StackOverflowError);
+  // A failed request must not leak its slot.
+  EXPECT_EQ(stack.pop(), 2);
+}
+
+TEST(StackFlatCombiningTest, HandlesClear) {
+  StackFlatCombining<int> stack(10);
+  stack.push(1);
+  stack.clear();
+  EXPECT_TRUE(stack.isEmpty());
+  EXPECT_EQ(stack.getCapacity(), 10);
+  EXPECT_NO_THROW(stack.push(1));
+}
+
+TEST(StackFlatCombiningTest, HandlesConcurrentPushPop) {
+  int numberOfThreads = 8;
+  int count = 20000;
+  // Fewer slots than threads, so that slots are shared.
+  StackFlatCombining<long> stack(numberOfThreads * count, 4);
+  std::atomic<long> sum(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < numberOfThreads; t++) {
+    threads.emplace_back([&stack, &sum, count] {
+      long local = 0;
+      for (int i = 1; i <= count; i++) {
+        stack.push(i);
+        if (i % 2 == 0) {
+          local += stack.pop();
+        }
+      }
+      sum += local;
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  while (stack.isEmpty() == false) {
+    sum += stack.pop();
+  }
+  EXPECT_EQ(sum, static_cast<long>(numberOfThreads) * count * (count + 1) / 2);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
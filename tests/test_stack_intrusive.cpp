@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "stack_intrusive.h"
+
+struct Item {
+  int value;
+  Item *next = nullptr;
+  Item *link = nullptr;
+};
+
+struct SharedItem {
+  int value;
+  std::atomic<SharedItem *> next{nullptr};
+};
+
+TEST(StackIntrusiveTest, HandlesConstructor) {
+  StackIntrusive<Item> stack(10);
+  EXPECT_EQ(stack.getCapacity(), 10);
+  EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(StackIntrusiveTest, HandlesInvalidCapacityError) {
+  EXPECT_THROW(StackIntrusive<Item> stack(0), StackInvalidCapacityError);
+}
+
+TEST(StackIntrusiveTest, HandlesPushPopLinksObjects) {
+  std::vector<Item> items(10);
+  StackIntrusive<Item> stack(10);
+  for (int i = 0; i < 10; i++) {
+    items[i].value = i;
+    stack.push(&items[i]);
+    EXPECT_EQ(stack.peek(), &items[i]);
+  }
+  EXPECT_TRUE(stack.isFull());
+  EXPECT_THROW(stack.push(&items[0]), StackOverflowError);
+  for (int i = 9; i >= 0; i--) {
+    Item *popped = stack.pop();
+    // The very same object comes back, not a copy.
+    EXPECT_EQ(popped, &items[i]);
+    EXPECT_EQ(popped->next, nullptr);
+  }
+  EXPECT_THROW(stack.pop(), StackUnderflowError);
+  EXPECT_THROW(stack.peek(), StackUnderflowError);
+}
+
+TEST(StackIntrusiveTest, HandlesCustomLinkMember) {
+  Item a{1};
+  Item b{2};
+  StackIntrusive<Item, &Item::link> byLink(10);
+  StackIntrusive<Item> byNext(10);
+  // One object can be on two stacks through two different links.
+  byLink.push(&a);
+  byLink.push(&b);
+  byNext.push(&b);
+  EXPECT_EQ(a.next, nullptr);
+  EXPECT_EQ(b.link, &a);
+  EXPECT_EQ(byLink.pop()->value, 2);
+  EXPECT_EQ(byNext.pop()->value, 2);
+  EXPECT_EQ(byLink.pop()->value, 1);
+}
+
+TEST(StackIntrusiveTest, HandlesMoveConstructorAndAssignment) {
+  Item a{1};
+  StackIntrusive<Item> s1(10);
+  s1.push(&a);
+  StackIntrusive<Item> s2 = std::move(s1);
+  EXPECT_EQ(s1.getCapacity(), 0);
+  EXPECT_TRUE(s1.isEmpty());
+  EXPECT_EQ(s2.getNumberOfElements(), 1);
+
+  StackIntrusive<Item> s3(1);
+  s3 = std::move(s2);
+  EXPECT_EQ(s3.getCapacity(), 10);
+  EXPECT_EQ(s3.pop(), &a);
+}
+
+TEST(StackIntrusiveTest, HandlesMarkRollback) {
+  std::vector<Item> items(5);
+  StackIntrusive<Item> stack(10);
+  stack.push(&items[0]);
+  StackMark mark = stack.mark();
+  for (int i = 1; i < 5; i++) {
+    stack.push(&items[i]);
+  }
+  stack.rollback(mark);
+  EXPECT_EQ(stack.peek(), &items[0]);
+}
+
+TEST(StackIntrusiveLockFreeTest, HandlesPushPop) {
+  std::vector<SharedItem> items(3);
+  StackIntrusiveLockFree<SharedItem> stack;
+  EXPECT_TRUE(stack.isEmpty());
+  EXPECT_EQ(stack.tryPop(), nullptr);
+  EXPECT_THROW(stack.pop(), StackUnderflowError);
+  for (SharedItem &item : items) {
+    stack.push(&item);
+  }
+  EXPECT_EQ(stack.pop(), &items[2]);
+  EXPECT_EQ(stack.pop(), &items[1]);
+  EXPECT_EQ(stack.tryPop(), &items[0]);
+  EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(StackIntrusiveLockFreeTest, HandlesConcurrentFreeList) {
+  // Threads repeatedly take objects from a shared free-list and return them,
+  // which is exactly the pattern that exposes ABA.
+  int numberOfItems = 64;
+  int numberOfThreads = 8;
+  int rounds = 20000;
+  std::vector<SharedItem> items(numberOfItems);
+  StackIntrusiveLockFree<SharedItem> freeList;
+  for (SharedItem &item : items) {
+    item.value = 0;
+    freeList.push(&item);
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < numberOfThreads; t++) {
+    threads.emplace_back([&freeList, rounds] {
+      for (int i = 0; i < rounds; i++) {
+        SharedItem *item = freeList.tryPop();
+        if (item != nullptr) {
+          item->value++;
+          freeList.push(item);
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  // Every object is back exactly once.
+  std::vector<int> seen(numberOfItems, 0);
+  while (SharedItem *item = freeList.tryPop()) {
+    seen[item - items.data()]++;
+  }
+  for (int count : seen) {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "stack_packed.h"
+
+TEST(StackPackedTest, HandlesConstructor) {
+  StackPacked<1> stack(100);
+  EXPECT_EQ(stack.getCapacity(), 100);
+  EXPECT_TRUE(stack.isEmpty());
+  // 100 bits fit in two words.
+  EXPECT_EQ(stack.getNumberOfBytes(), 16);
+}
+
+TEST(StackPackedTest, HandlesInvalidCapacityError) {
+  std::vector<int> stack_capacities = {-10, -1, 0};
+  for (int capacity : stack_capacities) {
+    EXPECT_THROW(StackPacked<1> stack(capacity), StackInvalidCapacityError);
+  }
+}
+
+TEST(StackPackedTest, HandlesPushPopBool) {
+  StackPacked<1> stack(200);
+  std::vector<bool> pushed;
+  for (int i = 0; i < 200; i++) {
+    bool value = (i * 7) % 3 == 0;
+    stack.push(value);
+    pushed.push_back(value);
+    EXPECT_EQ(stack.peek(), value);
+  }
+  EXPECT_TRUE(stack.isFull());
+  for (int i = 199; i >= 0; i--) {
+    EXPECT_EQ(stack.pop(), pushed[i]);
+  }
+  EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(StackPackedTest, HandlesPushPopTags) {
+  StackPacked<4> stack(50);
+  for (int i = 0; i < 50; i++) {
+    stack.push(static_cast<std::uint8_t>(i % 16));
+  }
+  for (int i = 49; i >= 0; i--) {
+    EXPECT_EQ(stack.pop(), i % 16);
+  }
+  EXPECT_THROW(stack.push(16), std::out_of_range);
+}
+
+TEST(StackPackedTest, HandlesEmptyAndFullErrors) {
+  StackPacked<2> stack(3);
+  EXPECT_THROW(stack.pop(), StackUnderflowError);
+  EXPECT_THROW(stack.peek(), StackUnderflowError);
+  for (int i = 0; i < 3; i++) {
+    stack.push(3);
+  }
+  EXPECT_THROW(stack.push(0), StackOverflowError);
+}
+
+template <int Bits>
+void checkPushPopMany(int before, int count) {
+  typedef typename StackPacked<Bits>::Value Value;
+  const int perWord = StackPacked<Bits>::kElementsPerWord;
+  std::mt19937 random(before * 1000 + count);
+  StackPacked<Bits> stack(before + count + 5);
+  StackPacked<Bits> reference(before + count + 5);
+  for (int i = 0; i < before; i++) {
+    Value value = static_cast<Value>(random() & ((1u << Bits) - 1));
+    stack.push(value);
+    reference.push(value);
+  }
+
+  std::vector<std::uint64_t> packed((count + perWord - 1) / perWord + 1, 0);
+  std::vector<Value> values;
+  for (int i = 0; i < count; i++) {
+    Value value = static_cast<Value>(random() & ((1u << Bits) - 1));
+    values.push_back(value);
+    packed[i / perWord] |= static_cast<std::uint64_t>(value)
+                           << (i % perWord * Bits);
+    reference.push(value);
+  }
+  // Garbage above `count` must be ignored.
+  packed.back() |= ~std::uint64_t(0) << ((count % perWord) * Bits % 64);
+  if (count % perWord == 0) {
+    packed.back() = ~std::uint64_t(0);
+  }
+  stack.pushMany(packed.data(), count);
+  ASSERT_EQ(stack.getNumberOfElements(), before + count);
+  EXPECT_EQ(stack.getPopulationCount(), reference.getPopulationCount());
+
+  std::vector<std::uint64_t> popped(packed.size(), 0);
+  stack.popMany(popped.data(), count);
+  for (int i = 0; i < count; i++) {
+    Value value = static_cast<Value>((popped[i / perWord] >> (i % perWord * Bits)) &
+                                     ((std::uint64_t(1) << Bits) - 1));
+    EXPECT_EQ(value, values[i]);
+  }
+  // Only the elements from before are left, and nothing above them.
+  EXPECT_EQ(stack.getNumberOfElements(), before);
+  for (int i = 0; i < count; i++) {
+    reference.pop();
+  }
+  EXPECT_EQ(stack.getPopulationCount(), reference.getPopulationCount());
+  while (stack.isEmpty() == false) {
+    EXPECT_EQ(stack.pop(), reference.pop());
+  }
+}
+
+TEST(StackPackedTest, HandlesPushPopMany) {
+  for (int before : {0, 1, 5, 63, 64, 65, 100}) {
+    for (int count : {0, 1, 7, 63, 64, 65, 130}) {
+      checkPushPopMany<1>(before, count);
+      checkPushPopMany<2>(before, count);
+      checkPushPopMany<4>(before, count);
+      checkPushPopMany<8>(before, count);
+    }
+  }
+}
+
+TEST(StackPackedTest, HandlesPopulationCountAndCount) {
+  StackPacked<2> stack(100);
+  int ones = 0;
+  std::vector<int> counts(4, 0);
+  for (int i = 0; i < 100; i++) {
+    std::uint8_t value = static_cast<std::uint8_t>((i * 5 + i / 3) % 4);
+    stack.push(value);
+    counts[value]++;
+    ones += (value & 1) + (value >> 1);
+  }
+  EXPECT_EQ(stack.getPopulationCount(), ones);
+  for (int value = 0; value < 4; value++) {
+    EXPECT_EQ(stack.count(static_cast<std::uint8_t>(value)), counts[value]);
+  }
+
+  StackPacked<1> bits(10);
+  bits.push(true);
+  bits.push(false);
+  bits.push(true);
+  EXPECT_EQ(bits.getPopulationCount(), 2);
+  // Free slots above the top are not counted as false.
+  EXPECT_EQ(bits.count(false), 1);
+}
+
+TEST(StackPackedTest, HandlesMarkRollback) {
+  StackPacked<1> stack(100);
+  for (int i = 0; i < 70; i++) {
+    stack.push(true);
+  }
+  StackMark mark = stack.mark();
+  for (int i = 0; i < 20; i++) {
+    stack.push(true);
+  }
+  stack.rollback(mark);
+  EXPECT_EQ(stack.getNumberOfElements(), 70);
+  EXPECT_EQ(stack.getPopulationCount(), 70);
+}
+
+TEST(StackPackedTest, HandlesCopyAndMove) {
+  StackPacked<8> s1(10);
+  for (int i = 0; i < 10; i++) {
+    s1.push(static_cast<std::uint8_t>(i * 20));
+  }
+  StackPacked<8> s2 = s1;
+  StackPacked<8> s3(1);
+  s3 = s1;
+  StackPacked<8> s4 = std::move(s1);
+  EXPECT_EQ(s1.getCapacity(), 0);
+  EXPECT_EQ(s1.getNumberOfElements(), 0);
+  for (int i = 9; i >= 0; i--) {
+    EXPECT_EQ(s2.pop(), i * 20);
+    EXPECT_EQ(s3.pop(), i * 20);
+    EXPECT_EQ(s4.pop(), i * 20);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "stack_ring.h"
+
+TEST(StackRingTest, HandlesConstructor) {
+  StackRing<int> stack(10);
+  EXPECT_EQ(stack.getCapacity(), 10);
+  EXPECT_TRUE(stack.isEmpty());
+  EXPECT_EQ(stack.getNumberOfEvictions(), 0);
+}
+
+TEST(StackRingTest, HandlesInvalidCapacityError) {
+  std::vector<int> stack_capacities = {-10, -1, 0};
+  for (int capacity : stack_capacities) {
+    EXPECT_THROW(StackRing<int> stack(capacity), StackInvalidCapacityError);
+  }
+}
+
+TEST(StackRingTest, HandlesPushPop) {
+  StackRing<int> stack(10);
+  for (int pushed = 0; pushed < 10; pushed++) {
+    stack.push(pushed);
+    EXPECT_EQ(stack.peek(), pushed);
+  }
+  for (int pushed = 9; pushed >= 0; pushed--) {
+    EXPECT_EQ(stack.pop(), pushed);
+  }
+  EXPECT_THROW(stack.pop(), StackUnderflowError);
+  EXPECT_THROW(stack.peek(), StackUnderflowError);
+}
+
+TEST(StackRingTest, HandlesEvictionInsteadOfOverflow) {
+  StackRing<int> stack(3);
+  for (int pushed = 0; pushed < 10; pushed++) {
+    EXPECT_NO_THROW(stack.push(pushed));
+  }
+  EXPECT_TRUE(stack.isFull());
+  EXPECT_EQ(stack.getNumberOfEvictions(), 7);
+  EXPECT_EQ(stack.at(0), 7);
+  EXPECT_EQ(stack.pop(), 9);
+  EXPECT_EQ(stack.pop(), 8);
+  EXPECT_EQ(stack.pop(), 7);
+  EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(StackRingTest, HandlesEvictionCallback) {
+  StackRing<std::string> stack(2);
+  std::vector<std::string> evicted;
+  stack.setEvictionCallback(
+      [&evicted](const std::string &value) { evicted.push_back(value); });
+  stack.push("a");
+  stack.push("b");
+  stack.push("c");
+  stack.pop();
+  stack.push("d");
+  stack.push("e");
+  EXPECT_EQ(evicted, (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(stack.pop(), "e");
+  EXPECT_EQ(stack.pop(), "d");
+}
+
+TEST(StackRingTest, HandlesCopyConstructorAndAssignment) {
+  StackRing<int> s1(4);
+  for (int i = 0; i < 7; i++) {
+    s1.push(i);
+  }
+  StackRing<int> s2 = s1;
+  StackRing<int> s3(1);
+  s3 = s1;
+  EXPECT_EQ(s2.getNumberOfEvictions(), 3);
+  EXPECT_EQ(s3.getCapacity(), 4);
+  for (int i = 6; i >= 3; i--) {
+    EXPECT_EQ(s1.pop(), i);
+    EXPECT_EQ(s2.pop(), i);
+    EXPECT_EQ(s3.pop(), i);
+  }
+  // The copies wrap around independently.
+  for (int i = 0; i < 5; i++) {
+    s2.push(i);
+  }
+  EXPECT_EQ(s2.at(0), 1);
+}
+
+TEST(StackRingTest, HandlesMoveConstructorAndAssignment) {
+  StackRing<int> s1(4);
+  for (int i = 0; i < 6; i++) {
+    s1.push(i);
+  }
+  StackRing<int> s2 = std::move(s1);
+  EXPECT_EQ(s1.getNumberOfElements(), 0);
+  EXPECT_EQ(s1.getCapacity(), 0);
+  EXPECT_EQ(s2.getNumberOfElements(), 4);
+
+  StackRing<int> s3(1);
+  s3 = std::move(s2);
+  EXPECT_EQ(s2.getCapacity(), 0);
+  EXPECT_EQ(s3.getCapacity(), 4);
+  EXPECT_EQ(s3.getNumberOfEvictions(), 2);
+  EXPECT_EQ(s3.pop(), 5);
+  EXPECT_THROW(s2.push(1), StackOverflowError);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "stack_spill.h"
+
+TEST(StackSpillTest, HandlesConstructor) {
+  StackSpill<int> stack(10);
+  EXPECT_EQ(stack.getCapacity(), 10);
+  EXPECT_EQ(stack.getBlockSize(), 4096);
+  EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(StackSpillTest, HandlesInvalidCapacityError) {
+  EXPECT_THROW(StackSpill<int> stack(0), StackInvalidCapacityError);
+  EXPECT_THROW(StackSpill<int> stack(10, 0), StackInvalidCapacityError);
+  EXPECT_THROW(StackSpill<int> stack(10, 4, 2), StackInvalidCapacityError);
+}
+
+TEST(StackSpillTest, HandlesEmptyAndFullErrors) {
+  StackSpill<int> stack(2, 1, 3);
+  EXPECT_THROW(stack.pop(), StackUnderflowError);
+  EXPECT_THROW(stack.peek(), StackUnderflowError);
+  stack.push(1);
+  stack.push(2);
+  EXPECT_THROW(stack.push(3), StackOverflowError);
+  EXPECT_EQ(stack.pop(), 2);
+}
+
+TEST(StackSpillTest, HandlesPushPopThroughSpillFile) {
+  int count = 100000;
+  StackSpill<std::int64_t> stack(count, 256, 4);
+  for (int i = 0; i < count; i++) {
+    stack.push(i);
+    EXPECT_LE(stack.getNumberOfResidentBlocks(), 4);
+  }
+  EXPECT_TRUE(stack.isFull());
+  EXPECT_GT(stack.getNumberOfBlockWrites(), 0);
+  for (int i = count - 1; i >= 0; i--) {
+    ASSERT_EQ(stack.peek(), i);
+    ASSERT_EQ(stack.pop(), i);
+    EXPECT_LE(stack.getNumberOfResidentBlocks(), 4);
+  }
+  EXPECT_TRUE(stack.isEmpty());
+  EXPECT_GT(stack.getNumberOfBlockReads(), 0);
+}
+
+TEST(StackSpillTest, HandlesDepthFirstPattern) {
+  // Go down and up again in waves, like a depth-first search.
+  StackSpill<int> stack(1 << 20, 64, 3);
+  std::vector<int> expected;
+  unsigned state = 1;
+  for (int round = 0; round < 200; round++) {
+    state = state * 1103515245 + 12345;
+    int pushes = static_cast<int>(state >> 16) % 2000;
+    for (int i = 0; i < pushes; i++) {
+      stack.push(static_cast<int>(expected.size()) * 7 + round);
+      expected.push_back(static_cast<int>(expected.size()) * 7 + round);
+    }
+    state = state * 1103515245 + 12345;
+    int pops = static_cast<int>(state >> 16) % 2000;
+    for (int i = 0; i < pops && !expected.empty(); i++) {
+      ASSERT_EQ(stack.pop(), expected.back());
+      expected.pop_back();
+    }
+  }
+  EXPECT_EQ(stack.getNumberOfElements(), static_cast<int>(expected.size()));
+  while (!expected.empty()) {
+    ASSERT_EQ(stack.pop(), expected.back());
+    expected.pop_back();
+  }
+}
+
+TEST(StackSpillTest, HandlesOscillationAtBlockBoundary) {
+  StackSpill<int> stack(1000, 10, 3);
+  for (int i = 0; i < 100; i++) {
+    stack.push(i);
+  }
+  long long writes = stack.getNumberOfBlockWrites();
+  long long reads = stack.getNumberOfBlockReads();
+  for (int i = 0; i < 1000; i++) {
+    stack.push(-1);
+    EXPECT_EQ(stack.pop(), -1);
+  }
+  // At most one block moves each way, not one per push/pop.
+  EXPECT_LE(stack.getNumberOfBlockWrites(), writes + 1);
+  EXPECT_LE(stack.getNumberOfBlockReads(), reads + 1);
+  EXPECT_EQ(stack.peek(), 99);
+}
+
+TEST(StackSpillTest, HandlesClear) {
+  StackSpill<int> stack(10000, 16, 3);
+  for (int i = 0; i < 5000; i++) {
+    stack.push(i);
+  }
+  stack.clear();
+  EXPECT_TRUE(stack.isEmpty());
+  EXPECT_EQ(stack.getCapacity(), 10000);
+  EXPECT_EQ(stack.getNumberOfResidentBlocks(), 0);
+  for (int i = 0; i < 1000; i++) {
+    stack.push(i);
+  }
+  for (int i = 999; i >= 0; i--) {
+    ASSERT_EQ(stack.pop(), i);
+  }
+}
+
+TEST(StackSpillTest, HandlesSpillPath) {
+  std::string path = ::testing::TempDir() + "stack_spill_test.bin";
+  {
+    StackSpill<double> stack(10000, 100, 3, path);
+    for (int i = 0; i < 10000; i++) {
+      stack.push(i * 0.5);
+    }
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    std::fclose(file);
+    for (int i = 9999; i >= 0; i--) {
+      ASSERT_EQ(stack.pop(), i * 0.5);
+    }
+  }
+  // The file is removed with the stack.
+  EXPECT_EQ(std::fopen(path.c_str(), "rb"), nullptr);
+}
+
+// Spills strings as a length followed by the characters.
+struct StringCodec {
+  static void encode(const std::string *values, int count,
+                     std::string &bytes) {
+    bytes.clear();
+    for (int i = 0; i < count; i++) {
+      std::uint32_t size = static_cast<std::uint32_t>(values[i].size());
+      bytes.append(reinterpret_cast<const char *>(&size), sizeof(size));
+      bytes.append(values[i]);
+    }
+  }
+
+  static void decode(const std::string &bytes, std::string *values,
+                     int count) {
+    std::size_t offset = 0;
+    for (int i = 0; i < count; i++) {
+      std::uint32_t size;
+      std::memcpy(&size, bytes.data() + offset, sizeof(size));
+      offset += sizeof(size);
+      values[i].assign(bytes, offset, size);
+      offset += size;
+    }
+  }
+};
+
+TEST(StackSpillTest, HandlesCustomCodec) {
+  StackSpill<std::string, StringCodec> stack(5000, 32, 3);
+  for (int i = 0; i < 5000; i++) {
+    stack.push(std::string(i % 50, 'a' + i % 26));
+  }
+  EXPECT_GT(stack.getNumberOfBlockWrites(), 0);
+  for (int i = 4999; i >= 0; i--) {
+    ASSERT_EQ(stack.pop(), std::string(i % 50, 'a' + i % 26));
+  }
+}
+
+// Fails to encode the third block, like a spill file on a full disk.
+struct FlakyCodec {
+  static int numberOfEncodes;
+
+  static void encode(const int *values, int count, std::string &bytes) {
+    if (++numberOfEncodes == 3) {
+      throw std::runtime_error("disk full");
+    }
+    SpillCodec<int>::encode(values, count, bytes);
+  }
+
+  static void decode(const std::string &bytes, int *values, int count) {
+    SpillCodec<int>::decode(bytes, values, count);
+  }
+};
+
+int FlakyCodec::numberOfEncodes = 0;
+
+TEST(StackSpillTest, HandlesWriteError) {
+  StackSpill<int, FlakyCodec> stack(1 << 20, 4, 3);
+  // The error reaches whichever push or pop next waits for the I/O thread,
+  // and `clear()` at the latest. The writes queued behind the failed one must
+  // not run.
+  bool thrown = false;
+  try {
+    for (int i = 0; i < 200; i++) {
+      stack.push(i);
+    }
+    while (!stack.isEmpty()) {
+      stack.pop();
+    }
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  if (!thrown) {
+    EXPECT_THROW(stack.clear(), std::runtime_error);
+  }
+}
+
+// Cannot read any block back.
+struct UnreadableCodec {
+  static void encode(const int *values, int count, std::string &bytes) {
+    SpillCodec<int>::encode(values, count, bytes);
+  }
+
+  static void decode(const std::string &, int *, int) {
+    throw std::runtime_error("corrupt block");
+  }
+};
+
+TEST(StackSpillTest, HandlesReadError) {
+  StackSpill<int, UnreadableCodec> stack(1 << 20, 4, 3);
+  for (int i = 0; i < 100; i++) {
+    stack.push(i);
+  }
+  // A pop that throws keeps its element, whether the failed prefetch is found
+  // on the way or waited for.
+  for (int i = 99; i >= 0; i--) {
+    try {
+      ASSERT_EQ(stack.pop(), i);
+    } catch (const std::runtime_error &) {
+      EXPECT_EQ(stack.getNumberOfElements(), i + 1);
+      return;
+    }
+    // Give the prefetch time to fail before the next pop.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  FAIL() << "No pop reported the read error.";
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}